@@ -0,0 +1,162 @@
+/**
+    \file allocationtracker.cpp
+    \brief Implementation of the AllocationTracker class and the counting allocation functions
+*/
+
+#include "allocationtracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace
+{
+    const std::size_t categories = static_cast<std::size_t>(AllocationCategory::Other) + 1;
+
+    // Counters of one operation type, the total is kept in the last slot
+    struct Counters
+    {
+        std::atomic<unsigned long long> allocations{ 0 };
+
+        std::atomic<unsigned long long> bytes{ 0 };
+
+        std::atomic<unsigned long long> live{ 0 };
+
+        std::atomic<unsigned long long> peak{ 0 };
+    };
+
+    Counters counters[categories + 1];
+
+    AllocationStats read(const Counters& c)
+    {
+        AllocationStats s;
+        s.allocations = c.allocations.load(std::memory_order_relaxed);
+        s.bytes = c.bytes.load(std::memory_order_relaxed);
+        s.peakLiveBytes = c.peak.load(std::memory_order_relaxed);
+        return s;
+    }
+
+#ifdef MATRIX_TRACK_ALLOCATIONS
+    void raisePeak(Counters& c, unsigned long long live)
+    {
+        unsigned long long peak = c.peak.load(std::memory_order_relaxed);
+        while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+    }
+
+    // Every block starts with a header telling its size and operation type,
+    // so a block is counted off the type it was allocated for
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        std::size_t size;
+
+        AllocationCategory category;
+    };
+
+    void* allocate(std::size_t size)
+    {
+        Header* h = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+        if (!h)
+            return nullptr;
+        h->size = size;
+        h->category = AllocationTracker::current;
+
+        for (Counters* c : { &counters[static_cast<std::size_t>(h->category)], &counters[categories] })
+        {
+            c->allocations.fetch_add(1, std::memory_order_relaxed);
+            c->bytes.fetch_add(size, std::memory_order_relaxed);
+            raisePeak(*c, c->live.fetch_add(size, std::memory_order_relaxed) + size);
+        }
+        return h + 1;
+    }
+
+    void deallocate(void* p)
+    {
+        if (!p)
+            return;
+        Header* h = static_cast<Header*>(p) - 1;
+        counters[static_cast<std::size_t>(h->category)].live.fetch_sub(h->size, std::memory_order_relaxed);
+        counters[categories].live.fetch_sub(h->size, std::memory_order_relaxed);
+        std::free(h);
+    }
+#endif
+}
+
+#ifdef MATRIX_TRACK_ALLOCATIONS
+thread_local AllocationCategory AllocationTracker::current = AllocationCategory::Other;
+
+void* operator new(std::size_t size)
+{
+    if (void* p = allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* p) noexcept { deallocate(p); }
+
+void operator delete(void* p, std::size_t) noexcept { deallocate(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+#endif
+
+bool AllocationTracker::available()
+{
+#ifdef MATRIX_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationStats AllocationTracker::stats(AllocationCategory category)
+{
+    return read(counters[static_cast<std::size_t>(category)]);
+}
+
+AllocationStats AllocationTracker::total()
+{
+    return read(counters[categories]);
+}
+
+void AllocationTracker::reset()
+{
+    for (Counters& c : counters)
+    {
+        c.allocations.store(0, std::memory_order_relaxed);
+        c.bytes.store(0, std::memory_order_relaxed);
+        c.peak.store(c.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+std::string AllocationTracker::name(AllocationCategory category)
+{
+    switch (category)
+    {
+    case AllocationCategory::Parse: return "parse";
+    case AllocationCategory::Copy: return "copy";
+    case AllocationCategory::Arithmetic: return "arithmetic";
+    case AllocationCategory::Evaluate: return "evaluate";
+    case AllocationCategory::ToString: return "toString";
+    default: return "other";
+    }
+}
+
+std::string AllocationTracker::report()
+{
+    if (!available())
+        return "Allocation tracking is not available";
+
+    std::string str;
+    for (std::size_t i = 0; i <= categories; i++)
+    {
+        const AllocationStats s = read(counters[i]);
+        str.append(i < categories ? name(static_cast<AllocationCategory>(i)) : "total");
+        str.append(": " + std::to_string(s.allocations) + " allocations, " + std::to_string(s.bytes) + " bytes, "
+            + std::to_string(s.peakLiveBytes) + " peak live bytes");
+        if (i < categories)
+            str.push_back('\n');
+    }
+    return str;
+}
@@ -0,0 +1,129 @@
+/**
+    \file allocationtracker.h
+    \brief Header for the AllocationTracker class
+*/
+
+#pragma once
+
+#include <string>
+
+/**
+    \brief Operation types the heap allocations are attributed to
+*/
+enum class AllocationCategory
+{
+    Parse,      ///< Constructing a matrix from a string
+    Copy,       ///< Copying a matrix
+    Arithmetic, ///< Addition, subtraction and multiplication
+    Evaluate,   ///< Evaluating a matrix
+    ToString,   ///< Creating the string representation of a matrix
+    Other       ///< Everything outside the operations above
+};
+
+/**
+    \struct AllocationStats
+    \brief Defines the allocation counts of one operation type
+*/
+struct AllocationStats
+{
+    unsigned long long allocations = 0;
+
+    unsigned long long bytes = 0;
+
+    /// Highest number of bytes allocated by the operation type and not yet freed at the same time
+    unsigned long long peakLiveBytes = 0;
+};
+
+/**
+    \class AllocationTracker
+    \brief Defines the counters of the heap allocations made by the matrix operations
+
+    Tracking is opt-in at compile time: only a program built with
+    MATRIX_TRACK_ALLOCATIONS defined in every translation unit replaces the
+    global operator new and counts. Otherwise the scopes compile to nothing
+    and every count stays zero.
+
+    An allocation is attributed to the outermost scope active on its thread,
+    so the copies made inside a multiplication count as arithmetic.
+*/
+class AllocationTracker
+{
+public:
+    /**
+        \class Scope
+        \brief Defines the operation type of the allocations made while the object lives
+    */
+    class Scope
+    {
+    public:
+        /**
+            \brief Parametric constructor
+            \param category operation type of the allocations
+        */
+        explicit Scope(AllocationCategory category)
+#ifdef MATRIX_TRACK_ALLOCATIONS
+            : outer(current)
+        {
+            if (current == AllocationCategory::Other)
+                current = category;
+        }
+
+        ~Scope() { current = outer; }
+#else
+        {
+            (void)category;
+        }
+#endif
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator =(const Scope&) = delete;
+
+#ifdef MATRIX_TRACK_ALLOCATIONS
+    private:
+        AllocationCategory outer;
+#endif
+    };
+
+    /**
+        \brief Getter for whether the program counts allocations
+        \return Boolean value telling whether MATRIX_TRACK_ALLOCATIONS was defined
+    */
+    static bool available();
+
+    /**
+        \brief Getter for the counts of one operation type since the last reset
+        \param category operation type
+        \return AllocationStats object of the operation type
+    */
+    static AllocationStats stats(AllocationCategory category);
+
+    /**
+        \brief Getter for the counts of all operation types since the last reset
+        \return AllocationStats object whose peak is the highest total of live bytes
+    */
+    static AllocationStats total();
+
+    /**
+        \brief Method for setting the counts to zero and the peaks to the bytes live now
+    */
+    static void reset();
+
+    /**
+        \brief Getter for the name of an operation type
+        \param category operation type
+        \return string such as "parse"
+    */
+    static std::string name(AllocationCategory category);
+
+    /**
+        \brief Method for creating a report of every operation type
+        \return string with one line per operation type
+    */
+    static std::string report();
+
+#ifdef MATRIX_TRACK_ALLOCATIONS
+    /// Operation type of the allocations on this thread
+    static thread_local AllocationCategory current;
+#endif
+};
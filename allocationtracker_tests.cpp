@@ -0,0 +1,99 @@
+/**
+    \file allocationtracker_tests.cpp
+    \brief Unit tests for the AllocationTracker class
+*/
+
+#include "catch.hpp"
+#include "allocationtracker.h"
+#include "elementarymatrix.h"
+#include <memory>
+#include <thread>
+
+TEST_CASE("AllocationTracker categories test", "[AllocationTracker]")
+{
+    CHECK(AllocationTracker::name(AllocationCategory::Parse) == "parse");
+    CHECK(AllocationTracker::name(AllocationCategory::ToString) == "toString");
+    CHECK(AllocationTracker::name(AllocationCategory::Other) == "other");
+
+    AllocationTracker::reset();
+    SymbolicSquareMatrix a{ "[[x,1][2,y]]" };
+    SymbolicSquareMatrix b{ a };
+    SymbolicSquareMatrix c = a * b;
+    ConcreteSquareMatrix d = c.evaluate(Valuation{ { 'x', 1 }, { 'y', 2 } });
+    std::string str = c.toString();
+
+    if (!AllocationTracker::available())
+    {
+        CHECK(AllocationTracker::total().allocations == 0);
+        CHECK(AllocationTracker::report() == "Allocation tracking is not available");
+        return;
+    }
+
+    const AllocationCategory used[] = { AllocationCategory::Parse, AllocationCategory::Copy, AllocationCategory::Arithmetic,
+        AllocationCategory::ToString };
+    unsigned long long sum = 0;
+    for (AllocationCategory category : used)
+    {
+        const AllocationStats s = AllocationTracker::stats(category);
+        CHECK(s.allocations > 0);
+        CHECK(s.bytes > 0);
+        sum += s.allocations;
+    }
+    CHECK(AllocationTracker::total().allocations >= sum);
+
+    // Evaluating a small matrix fills the inline cells of the result directly
+    CHECK(AllocationTracker::stats(AllocationCategory::Evaluate).allocations == 0);
+
+    // The copies inside the multiplication count as arithmetic
+    const unsigned long long copies = AllocationTracker::stats(AllocationCategory::Copy).allocations;
+    SymbolicSquareMatrix e = a * a;
+    CHECK(AllocationTracker::stats(AllocationCategory::Copy).allocations == copies);
+
+    // Allocations outside the matrix operations count as other
+    const unsigned long long other = AllocationTracker::stats(AllocationCategory::Other).allocations;
+    std::unique_ptr<int> p{ new int{ 5 } };
+    CHECK(AllocationTracker::stats(AllocationCategory::Other).allocations == other + 1);
+
+    AllocationTracker::reset();
+    CHECK(AllocationTracker::stats(AllocationCategory::Parse).allocations == 0);
+    CHECK(AllocationTracker::report().find("parse: 0 allocations, 0 bytes") == 0);
+}
+
+TEST_CASE("AllocationTracker peak live bytes test", "[AllocationTracker]")
+{
+    if (!AllocationTracker::available())
+        return;
+
+    AllocationTracker::reset();
+    const unsigned long long start = AllocationTracker::stats(AllocationCategory::Parse).peakLiveBytes;
+    {
+        // Each thread attributes its allocations to its own scopes
+        std::thread t{ []() { SymbolicSquareMatrix m{ "[[a,b,c][d,e,f][g,h,i]]" }; } };
+        t.join();
+    }
+    const AllocationStats parsed = AllocationTracker::stats(AllocationCategory::Parse);
+    CHECK(parsed.peakLiveBytes > start);
+    CHECK(parsed.peakLiveBytes <= parsed.bytes + start);
+
+    // Freed blocks lower the live bytes, so the same parse does not raise the peak again
+    { SymbolicSquareMatrix m{ "[[a,b,c][d,e,f][g,h,i]]" }; }
+    CHECK(AllocationTracker::stats(AllocationCategory::Parse).peakLiveBytes == parsed.peakLiveBytes);
+}
+
+TEST_CASE("AllocationTracker small concrete matrix test", "[AllocationTracker]")
+{
+    if (!AllocationTracker::available())
+        return;
+
+    // Up to 8 x 8 the operands, scratch buffers and results all stay inline
+    ConcreteSquareMatrix a{ "[[1,2,3,4][5,6,7,8][9,10,11,12][13,14,15,16]]" };
+    ConcreteSquareMatrix b{ "[[2,0,0,0][0,2,0,0][0,0,2,0][0,0,0,2]]" };
+    AllocationTracker::reset();
+    ConcreteSquareMatrix sum = a + b;
+    ConcreteSquareMatrix diff = a - b;
+    ConcreteSquareMatrix prod = a * b;
+    ConcreteSquareMatrix saturated = a.multiply(b, ArithmeticPolicy::Saturating);
+    ConcreteSquareMatrix value = a.evaluate(Valuation{});
+    CHECK(AllocationTracker::total().allocations == 0);
+    CHECK(prod == saturated);
+}
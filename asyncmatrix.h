@@ -0,0 +1,119 @@
+/**
+    \file asyncmatrix.h
+    \brief Header for the asynchronous matrix operations and the CancellationToken class
+*/
+
+#pragma once
+
+#include "elementarymatrix.h"
+#include "threadpool.h"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+/**
+    \class CancellationToken
+    \brief Defines a flag shared between the caller and the asynchronous operations it started
+
+    Copies of a token share the flag. Cancelling is cooperative: an operation
+    that has not started yet never runs, and a running one stops at its next
+    check. The future of a cancelled operation throws std::runtime_error
+    "Operation cancelled".
+*/
+class CancellationToken
+{
+public:
+    /**
+        \brief Default constructor, the token is not cancelled
+    */
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /**
+        \brief Method for cancelling every operation holding the token
+    */
+    void cancel() { flag->store(true); }
+
+    /**
+        \brief Getter for the state of the token
+        \return Boolean value telling whether the token is cancelled
+    */
+    bool cancelled() const { return flag->load(); }
+
+    /**
+        \brief Method for checking the token
+        \exception std::runtime_error Operation cancelled
+    */
+    void check() const
+    {
+        if (cancelled())
+            throw std::runtime_error("Operation cancelled");
+    }
+
+    /**
+        \brief Getter for the shared flag, valid as long as a copy of the token exists
+        \return pointer to the flag
+    */
+    const std::atomic<bool>* get() const { return flag.get(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+/**
+    \brief Function for multiplying two matrices on the shared thread pool
+    \param lhs shared pointer to the left hand side of the multiplication
+    \param rhs shared pointer to the right hand side of the multiplication
+    \param token token for cancelling the multiplication, checked before every row or row of tiles
+    \tparam Type type of the matrices
+    \return future holding the result of the multiplication
+*/
+template<typename Type>
+std::future<ElementarySquareMatrix<Type>> multiplyAsync(std::shared_ptr<const ElementarySquareMatrix<Type>> lhs,
+    std::shared_ptr<const ElementarySquareMatrix<Type>> rhs, CancellationToken token = CancellationToken{})
+{
+    return ThreadPool::shared().submit([lhs, rhs, token]()
+    {
+        token.check();
+        return lhs->multiply(*rhs, token.get());
+    });
+}
+
+/**
+    \brief Function for evaluating a matrix on the shared thread pool
+    \param m shared pointer to the matrix
+    \param v valuation object, copied for the operation
+    \param token token for cancelling the evaluation, checked before every row
+    \tparam Type type of the matrix
+    \return future holding the evaluated matrix
+*/
+template<typename Type>
+std::future<ConcreteSquareMatrix> evaluateAsync(std::shared_ptr<const ElementarySquareMatrix<Type>> m, Valuation v,
+    CancellationToken token = CancellationToken{})
+{
+    return ThreadPool::shared().submit([m, v, token]()
+    {
+        token.check();
+        return m->evaluate(v, token.get());
+    });
+}
+
+/**
+    \brief Function for raising a matrix to a power on the shared thread pool
+    \param m shared pointer to the matrix
+    \param k exponent
+    \param modulus optional modulus, 0 for none
+    \param token token for cancelling the exponentiation, checked between the products and inside them
+    \tparam Type type of the matrix
+    \return future holding the matrix to the power k
+*/
+template<typename Type>
+std::future<ElementarySquareMatrix<Type>> powerAsync(std::shared_ptr<const ElementarySquareMatrix<Type>> m, unsigned int k,
+    int modulus = 0, CancellationToken token = CancellationToken{})
+{
+    return ThreadPool::shared().submit([m, k, modulus, token]()
+    {
+        token.check();
+        return m->power(k, modulus, token.get());
+    });
+}
@@ -0,0 +1,98 @@
+/**
+    \file asyncmatrix_tests.cpp
+    \brief Unit tests for the ThreadPool class and the asynchronous matrix operations
+*/
+
+#include "catch.hpp"
+#include "asyncmatrix.h"
+#include <chrono>
+#include <vector>
+
+TEST_CASE("ThreadPool submit test", "[ThreadPool]")
+{
+    ThreadPool pool{ 2 };
+    CHECK(pool.size() == 2);
+    CHECK(ThreadPool::shared().size() > 0);
+
+    std::vector<std::future<int>> squares;
+    for (int i = 0; i < 20; i++)
+        squares.push_back(pool.submit([i]() { return i * i; }));
+    for (int i = 0; i < 20; i++)
+        CHECK(squares[i].get() == i * i);
+
+    // An exception reaches the caller through the future
+    std::future<void> failed = pool.submit([]() { throw std::invalid_argument("Incompatible matrices"); });
+    CHECK_THROWS_WITH(failed.get(), "Incompatible matrices");
+}
+
+TEST_CASE("Asynchronous matrix operations test", "[ConcreteSquareMatrix]")
+{
+    auto a = std::make_shared<const ConcreteSquareMatrix>("[[1,2][3,4]]");
+    auto b = std::make_shared<const ConcreteSquareMatrix>("[[0,1][1,0]]");
+    auto s = std::make_shared<const SymbolicSquareMatrix>("[[x,1][0,y]]");
+
+    std::future<ConcreteSquareMatrix> product = multiplyAsync(a, b);
+    std::future<SymbolicSquareMatrix> symbolic = multiplyAsync(s, s);
+    std::future<ConcreteSquareMatrix> value = evaluateAsync(s, Valuation{ { 'x', 2 }, { 'y', 3 } });
+    std::future<ConcreteSquareMatrix> cube = powerAsync(a, 3);
+    std::future<ConcreteSquareMatrix> reduced = powerAsync(a, 3, 5);
+    CHECK(product.get().toString() == "[[2,1][4,3]]");
+    CHECK(symbolic.get() == *s * *s);
+    CHECK(value.get().toString() == "[[2,1][0,3]]");
+    CHECK(cube.get().toString() == "[[37,54][81,118]]");
+    CHECK(reduced.get().toString() == "[[2,4][1,3]]");
+
+    CHECK_THROWS_WITH(multiplyAsync(a, std::make_shared<const ConcreteSquareMatrix>("[[1]]")).get(), "Incompatible matrices");
+    CHECK_THROWS_AS(evaluateAsync(s, Valuation{}).get(), std::exception);
+}
+
+TEST_CASE("Asynchronous matrix operations cancellation test", "[ConcreteSquareMatrix]")
+{
+    auto a = std::make_shared<const ConcreteSquareMatrix>("[[1,2][3,4]]");
+
+    // A token cancelled in advance stops every operation before it starts
+    CancellationToken early;
+    early.cancel();
+    CHECK(early.cancelled());
+    CHECK_THROWS_WITH(multiplyAsync(a, a, early).get(), "Operation cancelled");
+    CHECK_THROWS_WITH(evaluateAsync(a, Valuation{}, early).get(), "Operation cancelled");
+    CHECK_THROWS_WITH(powerAsync(a, 2, 0, early).get(), "Operation cancelled");
+
+    // A long exponentiation stops between its products
+    std::vector<long long> vals(160 * 160);
+    for (std::size_t i = 0; i < vals.size(); i++)
+        vals[i] = static_cast<long long>(i % 7);
+    auto big = std::make_shared<const ConcreteSquareMatrix>(ConcreteSquareMatrix::fromValues(160, vals));
+    CancellationToken token;
+    std::future<ConcreteSquareMatrix> slow = powerAsync(big, 4000000000u, 1000003, token);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    token.cancel();
+    CHECK_THROWS_WITH(slow.get(), "Operation cancelled");
+
+    // A long multiplication stops inside the product, extreme values keep it
+    // on the 128-bit Strassen path, which takes about a second to the end
+    std::vector<long long> wide(1024 * 1024);
+    for (std::size_t i = 0; i < wide.size(); i++)
+        wide[i] = (i % 2) ? INT_MAX - static_cast<long long>(i % 5) : INT_MIN + static_cast<long long>(i % 3);
+    auto huge = std::make_shared<const ConcreteSquareMatrix>(ConcreteSquareMatrix::fromValues(1024, wide));
+    CancellationToken stop;
+    std::future<ConcreteSquareMatrix> product = multiplyAsync(huge, huge, stop);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto cancelledAt = std::chrono::steady_clock::now();
+    stop.cancel();
+    CHECK_THROWS_WITH(product.get(), "Operation cancelled");
+    CHECK(std::chrono::steady_clock::now() - cancelledAt < std::chrono::milliseconds(250));
+
+    // The products and the evaluation check the flag inside their loops
+    std::atomic<bool> flag{ true };
+    SymbolicSquareMatrix s{ "[[x,1][0,y]]" };
+    CHECK_THROWS_WITH(a->multiply(*a, &flag), "Operation cancelled");
+    CHECK_THROWS_WITH(a->multiply(*a, ArithmeticPolicy::Checked, &flag), "Operation cancelled");
+    CHECK_THROWS_WITH(s.multiply(s, &flag), "Operation cancelled");
+    CHECK_THROWS_WITH(s.evaluate(Valuation{ { 'x', 2 }, { 'y', 3 } }, &flag), "Operation cancelled");
+    flag = false;
+    CHECK(a->multiply(*a, &flag).toString() == "[[7,10][15,22]]");
+
+    // Other tokens are not affected
+    CHECK(powerAsync(a, 2, 0, CancellationToken{}).get().toString() == "[[7,10][15,22]]");
+}
@@ -0,0 +1,241 @@
+/**
+    \file benchmark.cpp
+    \brief Microbenchmarks for the matrix and element operations
+*/
+
+#include "elementarymatrix.h"
+#include "allocationtracker.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Keeps the compiler from dropping the measured work
+    volatile std::size_t sink;
+
+    /**
+        \brief Result of one benchmark
+    */
+    struct Measurement
+    {
+        std::string operation;
+
+        std::string mix;
+
+        unsigned int n;
+
+        unsigned long long iterations;
+
+        double nsPerOp;
+
+        double allocsPerOp;
+
+        double bytesPerOp;
+    };
+
+    /**
+        \brief Function for a random matrix in the text format
+        \param n size of the matrix
+        \param variables fraction of the elements that are variables
+        \param rng random number generator
+        \return string of the matrix
+    */
+    std::string randomMatrix(unsigned int n, double variables, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<int> value(-99, 99);
+        std::uniform_int_distribution<int> letter(0, 3);
+        std::bernoulli_distribution isVariable(variables);
+
+        std::string str = "[";
+        for (unsigned int i = 0; i < n; i++)
+        {
+            str.push_back('[');
+            for (unsigned int j = 0; j < n; j++)
+            {
+                if (j > 0)
+                    str.push_back(',');
+                if (isVariable(rng))
+                    str.push_back(static_cast<char>('w' + letter(rng)));
+                else
+                    str.append(std::to_string(value(rng)));
+            }
+            str.push_back(']');
+        }
+        str.push_back(']');
+        return str;
+    }
+
+    /**
+        \brief Function for running an operation until the minimum time has passed
+        \param op operation to measure
+        \param minTime minimum measuring time
+        \return Measurement with the operation, mix and n left empty
+    */
+    Measurement measure(const std::function<void()>& op, std::chrono::nanoseconds minTime)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // One warm-up run, which also tells how many runs fit between clock reads
+        Clock::time_point start = Clock::now();
+        op();
+        const auto once = std::max<long long>((Clock::now() - start).count(), 1);
+        const unsigned long long batch = std::max<long long>(1, 1000000 / once);
+
+        unsigned long long iterations = 0;
+        const AllocationStats before = AllocationTracker::total();
+        start = Clock::now();
+        Clock::duration elapsed{};
+        while (elapsed < minTime)
+        {
+            for (unsigned long long i = 0; i < batch; i++)
+                op();
+            iterations += batch;
+            elapsed = Clock::now() - start;
+        }
+
+        Measurement m{};
+        m.iterations = iterations;
+        m.nsPerOp = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+        const AllocationStats after = AllocationTracker::total();
+        m.allocsPerOp = static_cast<double>(after.allocations - before.allocations) / iterations;
+        m.bytesPerOp = static_cast<double>(after.bytes - before.bytes) / iterations;
+        return m;
+    }
+
+    /**
+        \brief Function for the benchmarks of one matrix type
+        \param mix name of the element mix
+        \param n size of the matrices
+        \param variables fraction of the elements that are variables
+        \param minTime minimum measuring time of each operation
+        \param rng random number generator
+        \param filter only operations containing this string are measured
+        \param out vector receiving the measurements
+        \tparam Type type of the matrix elements
+    */
+    template<typename Type>
+    void benchmarkMatrix(const std::string& mix, unsigned int n, double variables, std::chrono::nanoseconds minTime,
+        std::mt19937& rng, const std::string& filter, std::vector<Measurement>& out)
+    {
+        using Matrix = ElementarySquareMatrix<Type>;
+        const std::string strA = randomMatrix(n, variables, rng);
+        const std::string strB = randomMatrix(n, variables, rng);
+        Matrix a{ strA };
+        Matrix b{ strB };
+        const Valuation v{ { 'w', 2 }, { 'x', -3 }, { 'y', 5 }, { 'z', 7 } };
+
+        const std::vector<std::pair<std::string, std::function<void()>>> ops{
+            { "parse", [&]() { Matrix m{ strA }; sink = m.getN(); } },
+            { "toString", [&]() { sink = a.toString().size(); } },
+            { "copy", [&]() { Matrix m{ a }; sink = m.getN(); } },
+            { "move", [&]() { Matrix m{ std::move(a) }; a = std::move(m); sink = a.getN(); } },
+            { "+", [&]() { sink = (a + b).getN(); } },
+            { "-", [&]() { sink = (a - b).getN(); } },
+            { "*", [&]() { sink = (a * b).getN(); } },
+            { "transpose", [&]() { sink = a.transpose().getN(); } },
+            { "evaluate", [&]() { sink = a.evaluate(v).getN(); } },
+        };
+
+        for (const auto& op : ops)
+        {
+            if (op.first.find(filter) == std::string::npos)
+                continue;
+            Measurement m = measure(op.second, minTime);
+            m.operation = op.first;
+            m.mix = mix;
+            m.n = n;
+            out.push_back(m);
+        }
+    }
+
+    /**
+        \brief Function for printing the command line usage
+        \param name name of the program
+    */
+    void usage(const char* name)
+    {
+        std::cerr << "Usage: " << name << " [--json] [--sizes n,n,...] [--time ms] [--filter operation] [--seed seed]" << std::endl
+            << "  --json    print one JSON object per measurement" << std::endl
+            << "  --sizes   matrix sizes to measure, 4,16,64 by default" << std::endl
+            << "  --time    minimum measuring time of each operation in milliseconds, 200 by default" << std::endl
+            << "  --filter  measure only the operations whose name contains the string" << std::endl
+            << "  --seed    seed of the random matrices" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool json = false;
+    std::vector<unsigned int> sizes{ 4, 16, 64 };
+    long long ms = 200;
+    std::string filter;
+    unsigned int seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--json")
+            json = true;
+        else if (arg == "--sizes" && hasValue)
+        {
+            sizes.clear();
+            std::istringstream list{ argv[++i] };
+            std::string item;
+            while (std::getline(list, item, ','))
+                sizes.push_back(static_cast<unsigned int>(std::stoul(item)));
+        }
+        else if (arg == "--time" && hasValue)
+            ms = std::stoll(argv[++i]);
+        else if (arg == "--filter" && hasValue)
+            filter = argv[++i];
+        else if (arg == "--seed" && hasValue)
+            seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!AllocationTracker::available())
+        std::cerr << "Allocations are counted only when built with MATRIX_TRACK_ALLOCATIONS" << std::endl;
+
+    std::mt19937 rng{ seed };
+    const std::chrono::nanoseconds minTime = std::chrono::milliseconds(ms);
+    std::vector<Measurement> results;
+    for (unsigned int n : sizes)
+    {
+        benchmarkMatrix<IntElement>("concrete", n, 0.0, minTime, rng, filter, results);
+        benchmarkMatrix<Element>("mixed", n, 0.25, minTime, rng, filter, results);
+        benchmarkMatrix<Element>("symbolic", n, 1.0, minTime, rng, filter, results);
+    }
+
+    if (!json)
+        std::cout << std::left << std::setw(10) << "operation" << std::setw(10) << "mix" << std::right << std::setw(6) << "n"
+            << std::setw(16) << "ns/op" << std::setw(14) << "allocs/op" << std::setw(14) << "bytes/op"
+            << std::setw(18) << "elements/s" << std::endl;
+
+    for (const Measurement& m : results)
+    {
+        // Throughput counts the elements of one operand
+        const double elementsPerSecond = 1e9 * m.n * m.n / m.nsPerOp;
+        if (json)
+            std::cout << "{\"operation\":\"" << m.operation << "\",\"mix\":\"" << m.mix << "\",\"n\":" << m.n
+                << ",\"iterations\":" << m.iterations << std::fixed << std::setprecision(2) << ",\"ns_per_op\":" << m.nsPerOp
+                << ",\"allocs_per_op\":" << m.allocsPerOp << ",\"bytes_per_op\":" << m.bytesPerOp
+                << ",\"elements_per_second\":" << std::setprecision(0) << elementsPerSecond << "}" << std::endl;
+        else
+            std::cout << std::left << std::setw(10) << m.operation << std::setw(10) << m.mix << std::right << std::setw(6) << m.n
+                << std::fixed << std::setprecision(1) << std::setw(16) << m.nsPerOp << std::setw(14) << m.allocsPerOp
+                << std::setw(14) << m.bytesPerOp << std::setprecision(0) << std::setw(18) << elementsPerSecond << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+/**
+    \file calculator.cpp
+    \brief Implementation of the Calculator class
+*/
+
+#include "calculator.h"
+#include "allocationtracker.h"
+#include "operationtimer.h"
+#include <cstdlib>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+
+bool isInt(const std::string& str)
+{
+    if (str.empty() || ((!isdigit(str[0])) && (str[0] != '-')))
+        return false;
+
+    char* p;
+    strtol(str.c_str(), &p, 10);
+
+    return (*p == 0);
+}
+
+Calculator::Calculator(std::ostream& os, bool interactive, bool quiet) : out(os), interactive(interactive), quiet(quiet) {}
+
+void Calculator::result(const std::string& str)
+{
+    if (!quiet)
+        message(str);
+}
+
+void Calculator::message(const std::string& str)
+{
+    out << str;
+    if (interactive)
+        out << std::endl;
+    else
+        out << '\n';
+}
+
+template<typename Op>
+void Calculator::binary(Op op)
+{
+    // Check that stack has enough operands
+    if (mystack.size() > 1)
+    {
+        // The operands are read in place, nothing is copied or popped before the result exists
+        const SymbolicSquareMatrix& lhs = *mystack[mystack.size() - 1];
+        const SymbolicSquareMatrix& rhs = *mystack[mystack.size() - 2];
+
+        // Check that operands have equal dimensions
+        if (lhs.getN() != rhs.getN())
+            message("Operation could not be executed");
+        else
+        {
+            MatrixHandle res{ op(lhs, rhs) };
+            mystack.pop_back();
+            mystack.pop_back();
+            mystack.push_back(std::move(res));
+            result(mystack.back()->toString());
+        }
+    }
+    else message("Operation could not be executed");
+}
+
+std::size_t Calculator::hashOf(const MatrixHandle& handle)
+{
+    if (!handle.entry->hash)
+    {
+        handle.entry->hash = handle->hash();
+        hashes++;
+    }
+    return *handle.entry->hash;
+}
+
+MatrixHandle Calculator::multiply(const MatrixHandle& lhs, const MatrixHandle& rhs)
+{
+    // The product is not commutative, so the order of the hashes matters
+    std::size_t key = hashOf(lhs);
+    key ^= hashOf(rhs) + static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) + (key << 6) + (key >> 2);
+
+    // A hash match counts only when the operands really are the same
+    auto it = products.find(key);
+    if (it != products.end())
+    {
+        const CachedProduct& c = it->second;
+        if ((c.lhs.entry == lhs.entry || *c.lhs == *lhs) && (c.rhs.entry == rhs.entry || *c.rhs == *rhs))
+        {
+            hits++;
+            return c.product;
+        }
+    }
+
+    MatrixHandle res{ *lhs * *rhs };
+
+    if (it != products.end())
+        it->second = CachedProduct{ lhs, rhs, res };
+    else
+    {
+        if (productOrder.size() == cacheCapacity)
+        {
+            products.erase(productOrder.front());
+            productOrder.pop_front();
+        }
+        products.emplace(key, CachedProduct{ lhs, rhs, res });
+        productOrder.push_back(key);
+    }
+
+    return res;
+}
+
+void Calculator::registerCommand(const std::string& command, const std::string& name)
+{
+    if (command == "store")
+    {
+        // The register shares the matrix with the stack
+        if (!mystack.empty())
+            registers.insert_or_assign(name, mystack.back());
+        else message("Operation could not be executed");
+    }
+    else
+    {
+        auto it = registers.find(name);
+        if (it != registers.end())
+            mystack.push_back(it->second);
+        else message("Operation could not be executed");
+    }
+}
+
+bool Calculator::execute(const std::string& inp)
+{
+    // The token after "store" or "load" is the name of the register
+    if (!pending.empty())
+    {
+        std::string command;
+        command.swap(pending);
+        registerCommand(command, inp);
+    }
+
+    else if (isSymbolicSquareMatrix(inp))
+        mystack.push_back(MatrixHandle{ SymbolicSquareMatrix{ inp } });
+
+    // Adding variable values
+    else if (inp[1] == '=' && isalpha(inp[0]) && isInt(inp.substr(inp.find("=") + 1)))
+    {
+        int val = std::stoi(inp.substr(inp.find("=") + 1));
+        v[inp[0]] = val;
+    }
+
+    // Addition
+    else if (inp == "+")
+        binary([](const SymbolicSquareMatrix& a, const SymbolicSquareMatrix& b) { return a + b; });
+
+    // Subtraction
+    else if (inp == "-")
+        binary([](const SymbolicSquareMatrix& a, const SymbolicSquareMatrix& b) { return a - b; });
+
+    // Multiplication
+    else if (inp == "*")
+    {
+        if (mystack.size() > 1 && mystack[mystack.size() - 1]->getN() == mystack[mystack.size() - 2]->getN())
+        {
+            MatrixHandle res = multiply(mystack[mystack.size() - 1], mystack[mystack.size() - 2]);
+            mystack.pop_back();
+            mystack.pop_back();
+            mystack.push_back(std::move(res));
+            result(mystack.back()->toString());
+        }
+        else message("Operation could not be executed");
+    }
+
+    // Registers
+    else if (inp == "store" || inp == "load")
+        pending = inp;
+
+    // Evaluating the top matrix from stack
+    else if (inp == "=")
+    {
+        if (!mystack.empty())
+            result(mystack.back()->evaluate(v).toString());
+        else message("Operation could not be executed");
+    }
+
+    // Allocation counts of the process
+    else if (inp == "allocs")
+        message(AllocationTracker::report());
+
+    // Latency histograms of the process
+    else if (inp == "stats")
+        message(OperationTimer::report());
+
+    else if (inp == "quit")
+        return false;
+
+    else message("Invalid input");
+
+    return true;
+}
+
+void Calculator::run(std::istream& in)
+{
+    std::string inp;
+    while (true)
+    {
+        if (interactive)
+            out << ">";
+        if (!(in >> inp))
+            break;
+
+        // Comments run to the end of the line
+        if (inp[0] == '#')
+        {
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            continue;
+        }
+
+        // A failing token only reports its message, the stack is left as it was
+        try
+        {
+            if (!execute(inp))
+                break;
+        }
+        catch (const std::exception& e)
+        {
+            message(e.what());
+        }
+    }
+
+    if (quiet && !mystack.empty())
+        message(mystack.back()->toString());
+    out.flush();
+}
+
+std::size_t Calculator::depth() const { return mystack.size(); }
+
+std::size_t Calculator::cacheHits() const { return hits; }
+
+std::size_t Calculator::hashesComputed() const { return hashes; }
@@ -0,0 +1,194 @@
+/**
+    \file calculator.h
+    \brief Header for the Calculator class
+*/
+
+#pragma once
+
+#include "element.h"
+#include "elementarymatrix.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <deque>
+#include <optional>
+
+/**
+    \brief Function for checking if a string is an integer
+    \param str string
+    \return Boolean value of the check
+*/
+bool isInt(const std::string& str);
+
+/**
+    \struct MatrixHandle
+    \brief Defines a shared handle to an immutable matrix and its structural hash
+
+    Copying the handle never copies the matrix. The hash is computed by the
+    first product cache lookup and kept next to the matrix, so every copy of
+    the handle sees it, later lookups do not walk the elements again and
+    matrices that are never multiplied are never hashed.
+*/
+struct MatrixHandle
+{
+    /**
+        \struct Entry
+        \brief Defines the matrix and its hash shared by the copies of a handle
+    */
+    struct Entry
+    {
+        SymbolicSquareMatrix matrix;
+
+        // Empty until the first product cache lookup
+        mutable std::optional<std::size_t> hash;
+    };
+
+    /**
+        \brief Parametric constructor
+        \param m matrix the handle takes over
+    */
+    explicit MatrixHandle(SymbolicSquareMatrix&& m)
+        : entry(std::make_shared<const Entry>(Entry{ std::move(m), std::nullopt })) {}
+
+    /**
+        \brief Operator for accessing the matrix
+        \return reference to the matrix
+    */
+    const SymbolicSquareMatrix& operator *() const { return entry->matrix; }
+
+    /**
+        \brief Operator for accessing the members of the matrix
+        \return pointer to the matrix
+    */
+    const SymbolicSquareMatrix* operator ->() const { return &entry->matrix; }
+
+    std::shared_ptr<const Entry> entry;
+};
+
+/**
+    \class Calculator
+    \brief Defines the RPN interpreter of the matrix calculator
+
+    Matrices are pushed on a stack, "x=3" sets a variable, "+", "-" and "*"
+    combine the two topmost matrices, "=" evaluates the top matrix and
+    "quit" ends the session. "store A" keeps the top matrix in the register
+    A and "load A" pushes it back. "allocs" prints the allocation counts of
+    AllocationTracker and "stats" the latencies of OperationTimer. A token
+    starting with '#' comments out the rest of the line. A token that fails,
+    like "=" with a variable that has no value, prints the error and the
+    session goes on.
+
+    Registers and the stack share handles, so neither copies matrices.
+    Products are remembered by the structural hashes of their operands,
+    which the handles keep once computed, so repeating a product returns
+    the earlier result.
+
+    Interactive sessions print a prompt before every token and flush every
+    line. Batch sessions print no prompts and leave the flushing to the
+    stream, and quiet sessions only print the top of the stack at the end.
+*/
+class Calculator
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param os stream the results and messages are printed in
+        \param interactive print prompts and flush every line
+        \param quiet print only the top of the stack when the session ends
+    */
+    Calculator(std::ostream& os, bool interactive = true, bool quiet = false);
+
+    /**
+        \brief Method for executing one token
+        \param token command, matrix or variable assignment
+        \return Boolean value telling whether the session continues
+    */
+    bool execute(const std::string& token);
+
+    /**
+        \brief Method for executing every token of a stream until "quit" or the end of the stream, printing the errors of failing tokens
+        \param in stream to read the tokens from
+    */
+    void run(std::istream& in);
+
+    /**
+        \brief Getter for the number of matrices on the stack
+        \return size_t value of the stack depth
+    */
+    std::size_t depth() const;
+
+    /**
+        \brief Getter for the number of products taken from the cache
+        \return size_t value of the cache hits
+    */
+    std::size_t cacheHits() const;
+
+    /**
+        \brief Getter for the number of structural hashes computed for the product cache
+        \return size_t value of the computed hashes
+    */
+    std::size_t hashesComputed() const;
+
+    /**
+        \brief Number of products the cache remembers, the oldest one is forgotten first
+    */
+    static const std::size_t cacheCapacity = 64;
+
+private:
+    std::ostream& out;
+
+    bool interactive;
+
+    bool quiet;
+
+    // The top of the stack is the back of the vector
+    std::vector<MatrixHandle> mystack;
+
+    Valuation v;
+
+    std::map<std::string, MatrixHandle> registers;
+
+    // Command waiting for its register name, empty when none is
+    std::string pending;
+
+    // A remembered product, the operands confirm a hash match
+    struct CachedProduct
+    {
+        MatrixHandle lhs;
+
+        MatrixHandle rhs;
+
+        MatrixHandle product;
+    };
+
+    std::unordered_map<std::size_t, CachedProduct> products;
+
+    // Keys of the products in the order they were added
+    std::deque<std::size_t> productOrder;
+
+    std::size_t hits = 0;
+
+    std::size_t hashes = 0;
+
+    // Returns the hash of the matrix, computing it on the first call for any copy of the handle
+    std::size_t hashOf(const MatrixHandle& handle);
+
+    // Returns the product of the operands from the cache or computes and remembers it
+    MatrixHandle multiply(const MatrixHandle& lhs, const MatrixHandle& rhs);
+
+    // Executes a register command once its name has been read
+    void registerCommand(const std::string& command, const std::string& name);
+
+    // Prints a result, which quiet sessions skip
+    void result(const std::string& str);
+
+    // Prints a message
+    void message(const std::string& str);
+
+    // Replaces the two topmost operands by the result of op when they have the same size
+    template<typename Op>
+    void binary(Op op);
+};
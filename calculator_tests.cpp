@@ -0,0 +1,111 @@
+/**
+    \file calculator_tests.cpp
+    \brief Unit tests for the Calculator class
+*/
+
+#include "catch.hpp"
+#include "calculator.h"
+#include <sstream>
+
+TEST_CASE("Calculator interactive session test", "[Calculator]")
+{
+    std::istringstream in{ "[[1,2][3,4]] [[x,0][0,1]] + x=2 = quit [[5]]" };
+    std::ostringstream out;
+    Calculator calc{ out };
+    calc.run(in);
+    CHECK(out.str() == ">>>[[(x+1),(0+2)][(0+3),(1+4)]]\n>>[[3,2][3,5]]\n>");
+    CHECK(calc.depth() == 1);
+}
+
+TEST_CASE("Calculator batch session test", "[Calculator]")
+{
+    std::istringstream in{ "# comment until the end of the line + - *\n[[1,2][3,4]]\n[[1,0][0,1]]\n*\n-\nfoo\n=\n" };
+    std::ostringstream out;
+    Calculator calc{ out, false };
+    calc.run(in);
+    CHECK(out.str() == "[[((1*1)+(0*3)),((1*2)+(0*4))][((0*1)+(1*3)),((0*2)+(1*4))]]\n"
+                       "Operation could not be executed\nInvalid input\n[[1,2][3,4]]\n");
+}
+
+TEST_CASE("Calculator quiet session test", "[Calculator]")
+{
+    std::istringstream in{ "[[1]] [[2]] + [[3]] * [[1,2][3,4]] *" };
+    std::ostringstream out;
+    Calculator calc{ out, false, true };
+    calc.run(in);
+    CHECK(out.str() == "Operation could not be executed\n[[1,2][3,4]]\n");
+    CHECK(calc.depth() == 2);
+
+    std::istringstream empty{ "" };
+    std::ostringstream none;
+    Calculator idle{ none, false, true };
+    idle.run(empty);
+    CHECK(none.str().empty());
+}
+
+TEST_CASE("Calculator operand handling test", "[Calculator]")
+{
+    // A failed operation leaves both operands where they were
+    std::istringstream in{ "[[2]] [[1,2][3,4]] + [[1,1][1,1]] + *" };
+    std::ostringstream out;
+    Calculator calc{ out, false };
+    calc.run(in);
+    CHECK(out.str() == "Operation could not be executed\n[[(1+1),(1+2)][(1+3),(1+4)]]\n"
+                       "Operation could not be executed\n");
+    CHECK(calc.depth() == 2);
+
+    // An error is printed and the session goes on with the same stack
+    std::istringstream unset{ "[[x]] = x=4 =" };
+    std::ostringstream errors;
+    Calculator failing{ errors, false };
+    failing.run(unset);
+    CHECK(errors.str() == "No value specified for the variable element\n[[4]]\n");
+    CHECK(failing.depth() == 1);
+}
+
+TEST_CASE("Calculator registers test", "[Calculator]")
+{
+    std::istringstream in{ "[[1,2][3,4]] store A [[x]] store B load A load A + load C store A x=2 load B = store" };
+    std::ostringstream out;
+    Calculator calc{ out, false };
+    calc.run(in);
+    CHECK(out.str() == "[[(1+1),(2+2)][(3+3),(4+4)]]\nOperation could not be executed\n[[2]]\n");
+    CHECK(calc.depth() == 4);
+
+    // Storing needs a matrix on the stack
+    std::istringstream none{ "store A load A" };
+    std::ostringstream msg;
+    Calculator empty{ msg, false };
+    empty.run(none);
+    CHECK(msg.str() == "Operation could not be executed\nOperation could not be executed\n");
+    CHECK(empty.depth() == 0);
+}
+
+TEST_CASE("Calculator product cache test", "[Calculator]")
+{
+    std::istringstream in{ "[[1,2][3,4]] store A load A load A * load A load A * [[1,2][3,4]] [[1,2][3,4]] * [[0,1][1,0]] load A *" };
+    std::ostringstream out;
+    Calculator calc{ out, false };
+    calc.run(in);
+    const std::string square = "[[((1*1)+(2*3)),((1*2)+(2*4))][((3*1)+(4*3)),((3*2)+(4*4))]]\n";
+    CHECK(out.str() == square + square + square + "[[((1*0)+(2*1)),((1*1)+(2*0))][((3*0)+(4*1)),((3*1)+(4*0))]]\n");
+
+    // Structurally equal operands hit the cache too, the swapped ones do not
+    CHECK(calc.cacheHits() == 2);
+    CHECK(calc.depth() == 5);
+    CHECK(calc.hashesComputed() == 4);
+}
+
+TEST_CASE("Calculator register hash test", "[Calculator]")
+{
+    // Every load of A shares the hash of the stored matrix, so it is computed once
+    std::istringstream in{ "[[x,1][0,y]] store A load A load A * load A load A * load A load A * [[x,1][0,y]] +" };
+    std::ostringstream out;
+    Calculator calc{ out, false, true };
+    calc.run(in);
+    CHECK(calc.hashesComputed() == 1);
+    CHECK(calc.cacheHits() == 2);
+
+    // Sums are never hashed
+    CHECK(calc.depth() == 4);
+}
@@ -13,6 +13,14 @@ CompositeElement::CompositeElement(const Element& e1, const Element& e2, const s
     op_fun = op;
 }
 
+CompositeElement::CompositeElement(std::unique_ptr<Element> e1, std::unique_ptr<Element> e2, const std::function<int(int, int)>& op, char opc)
+{
+    oprnd1 = std::move(e1);
+    oprnd2 = std::move(e2);
+    op_char = opc;
+    op_fun = op;
+}
+
 CompositeElement::CompositeElement(const CompositeElement& e)
 {
     oprnd1 = std::move(e.oprnd1->clone());
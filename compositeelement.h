@@ -27,6 +27,15 @@ public:
     */
     CompositeElement(const Element&, const Element&, const std::function<int(int, int)>&, char);
 
+    /**
+        \brief Parametric constructor that takes over the operands without cloning them
+        \param e1 unique_ptr to an Element object
+        \param e2 unique_ptr to an Element object
+        \param op reference to std::function<int(int,int)>
+        \param opc char that is the symbol of the operation
+    */
+    CompositeElement(std::unique_ptr<Element>, std::unique_ptr<Element>, const std::function<int(int, int)>&, char);
+
     /**
         \brief Copy constructor
         \param e CompositeElement object that is copied
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include <climits>
 
 // Is this the correct place for this?
 using Valuation = std::map<char, int>;
@@ -136,6 +137,7 @@ template<typename Type> class TElement: public Element
 			\param rhs reference to a TElement object that is the element to add
 			\tparam Type type of the class
 			\return Reference to a TElement object that is the result of the addition
+			\exception std::overflow_error Arithmetic overflow
 		*/
 		TElement<Type>& operator +=(const TElement<Type>& rhs);
 
@@ -144,6 +146,7 @@ template<typename Type> class TElement: public Element
 			\param rhs reference to a TElement object that is the element to subtract
 			\tparam Type type of the class
 			\return Reference to a TElement object that is the result of the subtraction
+			\exception std::overflow_error Arithmetic overflow
 		*/
 		TElement<Type>& operator -=(const TElement<Type>& rhs);
 
@@ -152,6 +155,7 @@ template<typename Type> class TElement: public Element
 			\param rhs reference to a TElement object that is the element to multiply with
 			\tparam Type type of the class
 			\return Reference to a TElement object that is the result of the multiplication
+			\exception std::overflow_error Arithmetic overflow
 		*/
 		TElement<Type>& operator *=(const TElement<Type>& rhs);
 
@@ -232,7 +236,11 @@ TElement<Type>& TElement<Type>::operator +=(const TElement<Type>& rhs)
 {
 	if (typeid(Type) == typeid(int))
 	{
-		val += rhs.val;
+		// Compute in 64 bits so that overflow is detected instead of being undefined
+		long long res = static_cast<long long>(val) + static_cast<long long>(rhs.val);
+		if (res < INT_MIN || res > INT_MAX)
+			throw std::overflow_error("Arithmetic overflow");
+		val = static_cast<Type>(res);
 		return *this;
 	}
 }
@@ -242,7 +250,11 @@ TElement<Type>& TElement<Type>::operator -=(const TElement<Type>& rhs)
 {
 	if (typeid(Type) == typeid(int))
 	{
-		val -= rhs.val;
+		// Compute in 64 bits so that overflow is detected instead of being undefined
+		long long res = static_cast<long long>(val) - static_cast<long long>(rhs.val);
+		if (res < INT_MIN || res > INT_MAX)
+			throw std::overflow_error("Arithmetic overflow");
+		val = static_cast<Type>(res);
 		return *this;
 	}
 }
@@ -252,7 +264,11 @@ TElement<Type>& TElement<Type>::operator *=(const TElement<Type>& rhs)
 {
 	if (typeid(Type) == typeid(int))
 	{
-		val *= rhs.val;
+		// Compute in 64 bits so that overflow is detected instead of being undefined
+		long long res = static_cast<long long>(val) * static_cast<long long>(rhs.val);
+		if (res < INT_MIN || res > INT_MAX)
+			throw std::overflow_error("Arithmetic overflow");
+		val = static_cast<Type>(res);
 		return *this;
 	}
 }
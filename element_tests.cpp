@@ -223,4 +223,15 @@ TEST_CASE("VariableElement toString() test", "[VariableElement]")
 {
     VariableElement e{ 'P' };
     CHECK(e.toString() == "P");
+}
+
+TEST_CASE("IntElement overflow test", "[IntElement]")
+{
+    IntElement e1{ 2147483647 };
+    IntElement e2{ 1 };
+    CHECK_THROWS_AS(e1 + e2, std::overflow_error);
+    CHECK_THROWS_WITH(e1 * IntElement{ 2 }, "Arithmetic overflow");
+    CHECK((e1 - e2).getVal() == 2147483646);
+    IntElement e3{ -2147483647 };
+    CHECK_THROWS_AS(e3 -= IntElement{ 2 }, std::overflow_error);
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 bool isSquareMatrix(const std::string& str)
 {
+    OperationTimer::Scope timer{ TimedOperation::IsSquareMatrix, str.size() };
+
     int brCount = 0;        // Brace counter
     int rowCount = 0;       // Row counter
     int colCount = 0;       // Column counter or a row dimension counter
@@ -105,6 +107,8 @@ bool isSquareMatrix(const std::string& str)
 // avoiding the need for testing such matrices
 bool isSymbolicSquareMatrix(const std::string& str)
 {
+    OperationTimer::Scope timer{ TimedOperation::IsSymbolicSquareMatrix, str.size() };
+
     int brCount = 0;        // Brace counter
     int rowCount = 0;       // Row counter
     int colCount = 0;       // Column counter or a row dimension counter
@@ -7,10 +7,19 @@
 
 #include "element.h"
 #include "compositeelement.h"
+#include "matrixkernels.h"
+#include "smallvector.h"
+#include "matrixview.h"
+#include "allocationtracker.h"
+#include "operationtimer.h"
 #include <vector>
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <functional>
+#include <atomic>
 
 /**
     \class TElement
@@ -58,7 +67,14 @@ template<typename Type> class ElementarySquareMatrix
             \tparam Type type of the class
             \return ElementarySquareMatrix object that is the transpose of the matrix
         */
-        ElementarySquareMatrix<Type> transpose();
+        ElementarySquareMatrix<Type> transpose() const;
+
+        /**
+            \brief Method for transposing the matrix in place
+            \tparam Type type of the class
+            \return Reference to the ElementarySquareMatrix object that has been transposed
+        */
+        ElementarySquareMatrix<Type>& transposeInPlace();
 
         /**
             \brief Method for creating a string representation of the matrix
@@ -86,6 +102,13 @@ template<typename Type> class ElementarySquareMatrix
         */
         bool operator ==(const ElementarySquareMatrix<Type>& rhs) const;
 
+        /**
+            \brief Method for a structural hash, equal matrices have equal hashes
+            \tparam Type type of the class
+            \return size_t value of the hash
+        */
+        std::size_t hash() const;
+
         /**
             \brief Operator for assignment
             \param m reference to a ElementarySquareMatrix object that is the matrix to assign from
@@ -108,6 +131,7 @@ template<typename Type> class ElementarySquareMatrix
             \return Reference to a ElementarySquareMatrix object that is the result of the addition
             \tparam Type type of the class
             \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
         */
         ElementarySquareMatrix<Type>& operator +=(const ElementarySquareMatrix<Type>& rhs);
 
@@ -117,6 +141,7 @@ template<typename Type> class ElementarySquareMatrix
             \return Reference to a ElementarySquareMatrix object that is the result of the subtraction
             \tparam Type type of the class
             \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
         */
         ElementarySquareMatrix<Type>& operator -=(const ElementarySquareMatrix<Type>& rhs);
 
@@ -126,6 +151,7 @@ template<typename Type> class ElementarySquareMatrix
             \return Reference to a ElementarySquareMatrix object that is the result of the multiplication
             \tparam Type type of the class
             \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
         */
         ElementarySquareMatrix<Type>& operator *=(const ElementarySquareMatrix<Type>& rhs);
 
@@ -136,8 +162,9 @@ template<typename Type> class ElementarySquareMatrix
             \return ElementarySquareMatrix object that is the result of the addition
             \tparam Type type of the class
             \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
         */
-        ElementarySquareMatrix<Type> operator +(const ElementarySquareMatrix<Type>& rhs);
+        ElementarySquareMatrix<Type> operator +(const ElementarySquareMatrix<Type>& rhs) const;
 
         /**
             \brief Operator for subtraction
@@ -146,8 +173,9 @@ template<typename Type> class ElementarySquareMatrix
             \return ElementarySquareMatrix object that is the result of the subtraction
             \tparam Type type of the class
             \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
         */
-        ElementarySquareMatrix<Type> operator -(const ElementarySquareMatrix<Type>& rhs);
+        ElementarySquareMatrix<Type> operator -(const ElementarySquareMatrix<Type>& rhs) const;
 
         /**
             \brief Operator for multiplication
@@ -156,19 +184,243 @@ template<typename Type> class ElementarySquareMatrix
             \return ElementarySquareMatrix object that is the result of the multiplication
             \tparam Type type of the class
             \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
         */
-        ElementarySquareMatrix<Type> operator *(const ElementarySquareMatrix<Type>& rhs);
+        ElementarySquareMatrix<Type> operator *(const ElementarySquareMatrix<Type>& rhs) const;
+
+        /**
+            \brief Method for multiplication that can be cancelled while it runs
+            \param rhs reference to a ElementarySquareMatrix object that is the matrix to multiply with
+            \param cancelled optional flag checked before every row or row of tiles of the product, nullptr for none
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object that is the result of the multiplication
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+            \exception std::runtime_error Operation cancelled
+        */
+        ElementarySquareMatrix<Type> multiply(const ElementarySquareMatrix<Type>& rhs, const std::atomic<bool>* cancelled) const;
 
         /**
             \brief Method for determining the value of each integer variable in the matrix
             \param v valuation object
+            \param cancelled optional flag checked before every row, nullptr for none
             \return ElementarySquareMatrix<IntElement> object that is the same matrix with variables replaced with the actual values
+            \exception std::runtime_error Operation cancelled
+        */
+        ElementarySquareMatrix<IntElement> evaluate(const Valuation& v, const std::atomic<bool>* cancelled = nullptr) const;
+
+        /**
+            \brief Method for raising the matrix to a non-negative integer power by binary exponentiation
+            \param k exponent, k = 0 gives the identity matrix
+            \param modulus optional modulus, 0 for none
+            \param cancelled optional flag checked between the products and inside them, nullptr for none
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object that is the matrix to the power k
+            \exception std::invalid_argument Invalid modulus
+            \exception std::runtime_error Operation cancelled
+        */
+        ElementarySquareMatrix<Type> power(unsigned int k, int modulus = 0, const std::atomic<bool>* cancelled = nullptr) const;
+
+        /**
+            \brief Method for the exact determinant of a concrete matrix by Bareiss fraction-free elimination
+            \tparam Type type of the class
+            \return long long value of the determinant
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+        */
+        long long determinant() const;
+
+        /**
+            \brief Method for the determinant as an expression of the elements by cofactor expansion
+            \tparam Type type of the class
+            \return unique_ptr to an Element object that evaluates to the determinant
+            \exception std::invalid_argument Matrix too large
+            \exception std::overflow_error Arithmetic overflow
+
+            The expansion has up to n! terms, so symbolic matrices larger than
+            symbolicDeterminantLimit are rejected. Concrete matrices of any
+            size use determinant().
+        */
+        std::unique_ptr<Element> symbolicDeterminant() const;
+
+        /**
+            \brief Largest size of a symbolic matrix symbolicDeterminant() expands
+        */
+        static const unsigned int symbolicDeterminantLimit = 8;
+
+        /**
+            \brief Method for the sum of the diagonal of a concrete matrix
+            \tparam Type type of the class
+            \return long long value of the trace
+            \exception std::invalid_argument Incompatible matrices
+        */
+        long long trace() const;
+
+        /**
+            \brief Method for the rank of a concrete matrix by elimination modulo primes
+            \tparam Type type of the class
+            \return unsigned int value of the rank
+            \exception std::invalid_argument Incompatible matrices
+        */
+        unsigned int rank() const;
+
+        /**
+            \brief Method for the characteristic polynomial det(xI - A) of a concrete matrix by Berkowitz's algorithm
+            \tparam Type type of the class
+            \return vector of the n + 1 coefficients, the coefficient of x^n first
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+        */
+        std::vector<long long> characteristicPolynomial() const;
+
+        /**
+            \brief Method for multiplying with the Strassen-Winograd algorithm
+            \param rhs reference to a ElementarySquareMatrix object that is the matrix to multiply with
+            \param crossover size at and below which the blocked classical kernel is used
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object that is the result of the multiplication
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+        */
+        ElementarySquareMatrix<Type> multiplyStrassen(const ElementarySquareMatrix<Type>& rhs, unsigned int crossover = 64) const;
+
+        /**
+            \brief Method for addition with a selectable overflow policy
+            \param rhs reference to a ElementarySquareMatrix object that is the matrix to add
+            \param policy how to handle results outside the int range
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object that is the result of the addition
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+        */
+        ElementarySquareMatrix<Type> add(const ElementarySquareMatrix<Type>& rhs, ArithmeticPolicy policy) const;
+
+        /**
+            \brief Method for subtraction with a selectable overflow policy
+            \param rhs reference to a ElementarySquareMatrix object that is the matrix to subtract
+            \param policy how to handle results outside the int range
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object that is the result of the subtraction
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+        */
+        ElementarySquareMatrix<Type> subtract(const ElementarySquareMatrix<Type>& rhs, ArithmeticPolicy policy) const;
+
+        /**
+            \brief Method for multiplication with a selectable overflow policy
+            \param rhs reference to a ElementarySquareMatrix object that is the matrix to multiply with
+            \param policy how to handle results outside the int range
+            \param cancelled optional flag checked before every row or row of tiles of the product, nullptr for none
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object that is the result of the multiplication
+            \exception std::invalid_argument Incompatible matrices
+            \exception std::overflow_error Arithmetic overflow
+            \exception std::runtime_error Operation cancelled
+        */
+        ElementarySquareMatrix<Type> multiply(const ElementarySquareMatrix<Type>& rhs, ArithmeticPolicy policy,
+            const std::atomic<bool>* cancelled = nullptr) const;
+
+        /**
+            \brief Size at and above which multiplication switches to the Strassen-Winograd algorithm
+        */
+        static const unsigned int strassenThreshold = 512;
+
+        /**
+            \brief Method for reading the integer values of the matrix into a row-major buffer
+            \return vector of the n * n values
+            \exception std::invalid_argument No value specified for the variable element
+        */
+        std::vector<long long> values() const;
+
+        /**
+            \brief Method for building a matrix of integer elements from a row-major buffer
+            \param size size n of the matrix
+            \param vals vector of the size * size values
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object holding the values
+        */
+        static ElementarySquareMatrix<Type> fromValues(unsigned int size, const std::vector<long long>& vals);
+
+        /**
+            \brief Method for the Kronecker product of two matrices
+            \param a reference to a ElementarySquareMatrix object that is the left hand side of the product
+            \param b reference to a ElementarySquareMatrix object that is the right hand side of the product
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object of size a.getN() * b.getN() made of the blocks a(i, j) * b
+            \exception std::overflow_error Arithmetic overflow
+        */
+        static ElementarySquareMatrix<Type> kron(const ElementarySquareMatrix<Type>& a, const ElementarySquareMatrix<Type>& b);
+
+        /**
+            \brief Method for assembling a matrix from a square grid of blocks, such as blockAssemble({{A,B},{C,D}})
+            \param blocks rows of the grid, every block must have the same size
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object made of the blocks
+            \exception std::invalid_argument Incompatible matrices
         */
-        ElementarySquareMatrix<IntElement> evaluate(const Valuation& v) const;
+        static ElementarySquareMatrix<Type> blockAssemble(const std::vector<std::vector<std::reference_wrapper<const ElementarySquareMatrix<Type>>>>& blocks);
+
+        /**
+            \brief Method for creating a non-owning view of the values of a concrete matrix
+            \return MatrixView object over the values
+            \exception std::invalid_argument Incompatible matrices
+        */
+        MatrixView<int> view() const;
+
+        /**
+            \brief Method for creating a non-owning transposed view of the values of a concrete matrix
+            \return MatrixView object over the values with rows and columns swapped
+            \exception std::invalid_argument Incompatible matrices
+        */
+        MatrixView<int> transposedView() const;
+
+        /**
+            \brief Number of cells a concrete matrix keeps inline before moving them to the heap
+        */
+        static const unsigned int inlineCells = 64;
 
 	private:
-		unsigned int n;
+		unsigned int n = 0;
 		std::vector<std::vector<std::unique_ptr<Element>>> elements;
+
+        // Values of a concrete matrix in row-major order, a symbolic matrix uses elements instead.
+        // Up to 8 x 8 matrices live inside the object and never touch the allocator.
+        SmallVector<int, inlineCells> cells;
+
+        /**
+            \brief Method for wrapping each element of the matrix into a modulo operation
+            \param modulus modulus
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object whose elements evaluate into [0, modulus)
+        */
+        ElementarySquareMatrix<Type> reduced(int modulus) const;
+
+        /**
+            \brief Method for expanding the minor of rows row ... n - 1 and the given columns along its first row
+            \param row first row of the minor
+            \param cols columns of the minor, restored on return
+            \tparam Type type of the class
+            \return unique_ptr to an Element object that evaluates to the minor
+        */
+        std::unique_ptr<Element> cofactorExpansion(unsigned int row, std::vector<unsigned int>& cols) const;
+
+        /**
+            \brief Method for widening the values of a concrete matrix into a 64-bit scratch buffer
+            \return SmallVector of the n * n values, inline up to inlineCells values
+        */
+        SmallVector<long long, inlineCells> wideCells() const;
+
+        /**
+            \brief Method for building a matrix of integer elements from a row-major buffer
+            \param size size n of the matrix
+            \param vals pointer to the size * size values in the int range
+            \tparam Type type of the class
+            \return ElementarySquareMatrix object holding the values
+        */
+        static ElementarySquareMatrix<Type> fromBuffer(unsigned int size, const long long* vals);
+
+        // evaluate() of a symbolic matrix builds a concrete one from a buffer
+        template<typename> friend class ElementarySquareMatrix;
 };
 
 /**
@@ -197,9 +449,26 @@ using ConcreteSquareMatrix = ElementarySquareMatrix<IntElement>;
 */
 using SymbolicSquareMatrix = ElementarySquareMatrix<Element>;
 
+/**
+    \brief Function for the Kronecker product of two matrices
+    \param a reference to a ElementarySquareMatrix object that is the left hand side of the product
+    \param b reference to a ElementarySquareMatrix object that is the right hand side of the product
+    \tparam Type type of the matrices
+    \return ElementarySquareMatrix object of size a.getN() * b.getN() made of the blocks a(i, j) * b
+    \exception std::overflow_error Arithmetic overflow
+*/
+template<typename Type>
+ElementarySquareMatrix<Type> kron(const ElementarySquareMatrix<Type>& a, const ElementarySquareMatrix<Type>& b)
+{
+    return ElementarySquareMatrix<Type>::kron(a, b);
+}
+
 template<typename Type>
 ElementarySquareMatrix<Type>::ElementarySquareMatrix(const std::string& str_m)
 {
+    AllocationTracker::Scope scope{ AllocationCategory::Parse };
+    OperationTimer::Scope timer{ TimedOperation::Parse, str_m.size() };
+
 	if (isSquareMatrix(str_m) && (typeid(Type) == typeid(IntElement)))
 	{
         if (str_m == "[[]]") { n = 0; }
@@ -210,9 +479,8 @@ ElementarySquareMatrix<Type>::ElementarySquareMatrix(const std::string& str_m)
             // '[' or ']' increments n
             n = std::count(str_m.begin() + 1, str_m.end(), '[');
 
-            // Initialize row container
-            //                                                                              EDITED
-            std::vector<std::unique_ptr<Element>> row;
+            // Values go straight into the row-major cells
+            cells.reserve(n * n);
 
             // Initialize string where each element's value is read into
             std::string sr = "";
@@ -224,18 +492,9 @@ ElementarySquareMatrix<Type>::ElementarySquareMatrix(const std::string& str_m)
                 // If the current character denotes next element or next row
                 else if (*ite == ',' || *ite == ']')
                 {
-                    //                                                                      EDITED
-
-                    // Push back the string representation of the current element into the row under construction
-                    std::unique_ptr<Element> pt(new IntElement{ stoi(sr) });
-                    row.push_back(std::move(pt));
+                    // Push back the value of the current element
+                    cells.push_back(stoi(sr));
                     sr = "";
-                    // If row comes to an end, push the row into the elements vector
-                    if (*ite == ']')
-                    {
-                        elements.push_back(std::move(row));
-                        row.clear();
-                    }
                 }
 
                 // Read current character into the string
@@ -301,10 +560,7 @@ ElementarySquareMatrix<Type>::ElementarySquareMatrix(const std::string& str_m)
 template<typename Type>
 ElementarySquareMatrix<Type>::ElementarySquareMatrix()
 {
-    if (typeid(Type) == typeid(IntElement))
-        ConcreteSquareMatrix{ "[[]]" };
-    else if (typeid(Type) == typeid(Element))
-        SymbolicSquareMatrix{ "[[]]" };
+    // The empty matrix, n and the containers are already initialized
 }
 
 // A symbolic square matrix that is the result of arithmetic
@@ -323,12 +579,9 @@ ElementarySquareMatrix<Type>::ElementarySquareMatrix(ElementarySquareMatrix<Type
 
     if (typeid(Type) == typeid(IntElement))
     {
-        for (auto ite = m.elements.begin(); ite != m.elements.end(); ite++)
-        {
-            elements.push_back(std::move(*ite));
-        }
+        cells = std::move(m.cells);
         n = m.n;
-        m.elements.clear();
+        m.n = 0;
     }
     else if (typeid(Type) == typeid(Element))
     {
@@ -338,33 +591,36 @@ ElementarySquareMatrix<Type>::ElementarySquareMatrix(ElementarySquareMatrix<Type
         }
         n = m.n;
         m.elements.clear();
+        m.n = 0;
     }
 }
 
 template<typename Type>
 std::string ElementarySquareMatrix<Type>::toString() const
 {
+    AllocationTracker::Scope scope{ AllocationCategory::ToString };
+    OperationTimer::Scope timer{ TimedOperation::ToString, n };
+
     if (typeid(Type) == typeid(IntElement))
     {
         // Initialize the string
         std::string str = "[";
 
         // Empty matrix case
-        if (elements.empty())
+        if (cells.empty())
             str.append("[]]");
 
         else
         {
             // Go through each row
-            for (const auto& row : elements)
+            for (unsigned int i = 0; i < n; i++)
             {
                 // Add the beginning of a new row
                 str.push_back('[');
                 // Add each element and separate them with ','
-                for (const auto& c : row)
+                for (unsigned int j = 0; j < n; j++)
                 {
-                    //                                                                      EDITED
-                    str.append(c->toString());
+                    str.append(std::to_string(cells[i * n + j]));
                     str.push_back(',');
                 }
 
@@ -436,29 +692,79 @@ template<typename Type>
 unsigned int ElementarySquareMatrix<Type>::getN() const { return n; }
 
 template<typename Type>
-ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::transpose()
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::transpose() const
 {
-    ElementarySquareMatrix<Type> m{ *this };
-    for (unsigned int i = 0; i < n; i++)
+    if (typeid(Type) == typeid(IntElement))
     {
-        for (unsigned int j = 0; j < n; j++)
-        {
-            m.elements[i][j] = elements[j][i]->clone();
-        }
+        ElementarySquareMatrix<Type> m;
+        m.n = n;
+        m.cells.resize(cells.size());
+        transposeKernel(cells.data(), m.cells.data(), n);
+        return m;
     }
 
+    // Clone each element tree once, then only move the pointers around
+    ElementarySquareMatrix<Type> m{ *this };
+    m.transposeInPlace();
     return m;
 }
 
+template<typename Type>
+ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::transposeInPlace()
+{
+    if (typeid(Type) == typeid(IntElement))
+    {
+        int* c = cells.data();
+        const unsigned int size = n;
+        auto swapCells = [c, size](unsigned int i, unsigned int j) { std::swap(c[i * size + j], c[j * size + i]); };
+        transposeInPlaceKernel(0, n, swapCells);
+    }
+    else
+    {
+        auto swapCells = [this](unsigned int i, unsigned int j) { elements[i][j].swap(elements[j][i]); };
+        transposeInPlaceKernel(0, n, swapCells);
+    }
+
+    return *this;
+}
+
 template<typename Type>
 bool ElementarySquareMatrix<Type>::operator ==(const ElementarySquareMatrix<Type>& rhs) const
 {
+    // Concrete matrices can compare their values without building strings
+    if (typeid(Type) == typeid(IntElement))
+        return (this->cells == rhs.cells);
+
     return (this->toString() == rhs.toString());
 }
 
+template<typename Type>
+std::size_t ElementarySquareMatrix<Type>::hash() const
+{
+    std::size_t h = std::hash<unsigned int>()(n);
+    auto mix = [&h](std::size_t v) { h ^= v + static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) + (h << 6) + (h >> 2); };
+
+    if (typeid(Type) == typeid(IntElement))
+    {
+        for (int c : cells)
+            mix(std::hash<int>()(c));
+    }
+    else
+    {
+        // Elements are hashed by their string form, which is what operator == compares
+        for (const auto& row : elements)
+            for (const auto& e : row)
+                mix(std::hash<std::string>()(e->toString()));
+    }
+
+    return h;
+}
+
 template<typename Type>
 ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::operator =(const ElementarySquareMatrix<Type>& m)
 {
+    AllocationTracker::Scope scope{ AllocationCategory::Copy };
+
     if (m == *this)
         return *this;
     else
@@ -477,6 +783,7 @@ ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::operator =(const Ele
             }
             this->elements.push_back(std::move(row));
         }
+        this->cells = m.cells;
 
         // Set correct n
         this->n = m.n;
@@ -500,150 +807,75 @@ ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::operator =(Elementar
             this->elements.push_back(std::move(i));
         }
 
+        this->cells = std::move(m.cells);
+
         // Set correct n
         this->n = m.n;
 
-        // Empty the move assigned matrix and set the correct n
+        // Empty the move assigned matrix, its size has to match the emptied cells
         m.elements.clear();
-        m.n = 1;
+        m.n = 0;
 
         return *this;
     }
 }
 
 template<typename Type>
-ElementarySquareMatrix<IntElement> ElementarySquareMatrix<Type>::evaluate(const Valuation& v) const
+ElementarySquareMatrix<IntElement> ElementarySquareMatrix<Type>::evaluate(const Valuation& v, const std::atomic<bool>* cancelled) const
 {
-    // Initialize the string representation
-    std::string str = "[";
+    AllocationTracker::Scope scope{ AllocationCategory::Evaluate };
+    OperationTimer::Scope timer{ TimedOperation::Evaluate, n };
 
-    // Empty matrix case
-    if (elements.empty())
-        str.append("[]]");
+    if (typeid(Type) == typeid(IntElement))
+        return ConcreteSquareMatrix::fromBuffer(n, wideCells().data());
 
-    else
+    // Evaluate each element straight into a row-major buffer
+    SmallVector<long long, inlineCells> vals;
+    vals.reserve(n * n);
+    for (const auto& row : elements)
     {
-        for (const auto& row : elements)
-        {
-            // At the beginnning of row, add '['
-            str.push_back('[');
-
-            for (const auto& c : row)
-            {
-                // Add a string representation of the current element and ','
-                str.append(std::to_string(c->evaluate(v)));
-                str.push_back(',');
-            }
-            // At the end, remove last ',' and add ']'
-            str.pop_back();
-            str.push_back(']');
-        }
-
-        // Close the matrix with ']'
-        str.push_back(']');
+        cancellationKernel(cancelled);
+        for (const auto& c : row)
+            vals.push_back(c->evaluate(v));
     }
-    ConcreteSquareMatrix m(str);
 
-    return m;
+    return ConcreteSquareMatrix::fromBuffer(n, vals.data());
 }
 
 template<typename Type>
 ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::operator +=(const ElementarySquareMatrix<Type>& rhs)
 {
-    // Check dimensions and type
-    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
-        throw std::invalid_argument("Incompatible matrices");
-
-    for (unsigned int i = 0; i < n; i++)
-    {
-        for (unsigned int j = 0; j < n; j++)
-        {
-            // This should be done more elegantly, but the problem is that
-            // elements is a vector of uniq_ptrs to Elements rather than
-            // <Type>. Fixing this at this point would require changing so much
-            // and it would not be guaranteed to work
-            IntElement eLhs{ std::stoi(this->elements[i][j]->toString()) };
-            IntElement eRhs{ std::stoi(rhs.elements[i][j]->toString()) };
-            eLhs += eRhs;
-            this->elements[i][j] = eLhs.clone();
-        }
-    }
-
+    *this = add(rhs, ArithmeticPolicy::Widening);
     return *this;
 }
 
 template<typename Type>
 ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::operator -=(const ElementarySquareMatrix<Type>& rhs)
 {
-    // Check dimensions and type
-    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
-        throw std::invalid_argument("Incompatible matrices");
-
-    for (unsigned int i = 0; i < n; i++)
-    {
-        for (unsigned int j = 0; j < n; j++)
-        {
-            // This should be done more elegantly, but the problem is that
-            // elements is a vector of uniq_ptrs to Elements rather than
-            // <Type>. Fixing this at this point would require changing so much
-            // and it would not be guaranteed to work
-            IntElement eLhs{ std::stoi(this->elements[i][j]->toString()) };
-            IntElement eRhs{ std::stoi(rhs.elements[i][j]->toString()) };
-            eLhs -= eRhs;
-            this->elements[i][j] = eLhs.clone();
-        }
-    }
-
+    *this = subtract(rhs, ArithmeticPolicy::Widening);
     return *this;
 }
 
 template<typename Type>
 ElementarySquareMatrix<Type>& ElementarySquareMatrix<Type>::operator *=(const ElementarySquareMatrix<Type>& rhs)
 {
-    // Check dimensions and type
-    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
-        throw std::invalid_argument("Incompatible matrices");
-
-    ElementarySquareMatrix<Type> lhs{ *this };
-    auto multi = [lhs, &rhs](int i, int j, int k)
-    {
-        return std::stoi(lhs.elements[i][k]->toString()) * std::stoi(rhs.elements[k][j]->toString());
-    };
-
-    // This should be done more elegantly, but the problem is that
-    // elements is a vector of uniq_ptrs to Elements rather than
-    // <Type>. Fixing this at this point would require changing so much
-    // and it would not be guaranteed to work
-    for (unsigned int i = 0; i < n; i++)
-    {
-        for (unsigned int j = 0; j < n; j++)
-        {
-            int res = 0;
-            for (unsigned int k = 0; k < n; k++)
-            {
-                res = res + multi(i, j, k);
-            }
-            IntElement eRes{ res };
-            this->elements[i][j] = eRes.clone();
-        }
-    }
-
+    *this = multiply(rhs, ArithmeticPolicy::Widening);
     return *this;
 }
 
 template<typename Type>
-ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator +(const ElementarySquareMatrix<Type>& rhs)
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator +(const ElementarySquareMatrix<Type>& rhs) const
 {
+    AllocationTracker::Scope scope{ AllocationCategory::Arithmetic };
+    OperationTimer::Scope timer{ TimedOperation::Add, n };
+
     // Check dimensions and type
     if (this->getN() != rhs.getN())
         throw std::invalid_argument("Incompatible matrices");
 
+    // The kernel output becomes the result directly, without a round trip through a string
     else if (typeid(Type) == typeid(IntElement))
-    {
-        ElementarySquareMatrix<Type> res{ this->toString() };
-        res += rhs;
-        return res;
-    }
+        return add(rhs, ArithmeticPolicy::Widening);
 
     else if (typeid(Type) == typeid(Element))
     {
@@ -664,18 +896,18 @@ ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator +(const Elem
 }
 
 template<typename Type>
-ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator -(const ElementarySquareMatrix<Type>& rhs)
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator -(const ElementarySquareMatrix<Type>& rhs) const
 {
+    AllocationTracker::Scope scope{ AllocationCategory::Arithmetic };
+    OperationTimer::Scope timer{ TimedOperation::Subtract, n };
+
     // Check dimensions and type
     if (this->getN() != rhs.getN())
         throw std::invalid_argument("Incompatible matrices");
 
+    // The kernel output becomes the result directly, without a round trip through a string
     else if (typeid(Type) == typeid(IntElement))
-    {
-        ElementarySquareMatrix<Type> res{ this->toString() };
-        res -= rhs;
-        return res;
-    }
+        return subtract(rhs, ArithmeticPolicy::Widening);
 
     else if (typeid(Type) == typeid(Element))
     {
@@ -696,19 +928,24 @@ ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator -(const Elem
 }
 
 template<typename Type>
-ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator *(const ElementarySquareMatrix<Type>& rhs)
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator *(const ElementarySquareMatrix<Type>& rhs) const
 {
+    return multiply(rhs, nullptr);
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::multiply(const ElementarySquareMatrix<Type>& rhs, const std::atomic<bool>* cancelled) const
+{
+    AllocationTracker::Scope scope{ AllocationCategory::Arithmetic };
+    OperationTimer::Scope timer{ TimedOperation::Multiply, n };
+
     // Check dimensions and type
     if (this->getN() != rhs.getN())
         throw std::invalid_argument("Incompatible matrices");
 
-    
-    else if (typeid(Type) == typeid(IntElement) && isSquareMatrix(this->toString()))
-    {
-        ElementarySquareMatrix<Type> res{ this->toString() };
-        res *= rhs;
-        return res;
-    }
+    // The kernel output becomes the result directly, without a round trip through a string
+    else if (typeid(Type) == typeid(IntElement))
+        return multiply(rhs, ArithmeticPolicy::Widening, cancelled);
 
     else if (typeid(Type) == typeid(Element))
     {
@@ -716,33 +953,26 @@ ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator *(const Elem
         m.n = rhs.getN();
         for (unsigned int i = 0; i < n; ++i)
         {
+            cancellationKernel(cancelled);
+
             // Initialize a row vector
             std::vector<std::unique_ptr<Element>> row;
             for (unsigned int j = 0; j < n; j++)
             {
-                // Store all integer pairs that are to be summed into a vector
-                std::vector<CompositeElement> store;
+                // Each product clones its operands once, the sum then takes the products over
+                // without cloning, so the element [i][j] is ((p0+p1)+p2)+...
+                std::unique_ptr<Element> sum;
                 for (unsigned int k = 0; k < n; k++)
                 {
-                    store.push_back(CompositeElement(*elements[i][k], *rhs.elements[k][j], std::multiplies<int>(), '*'));
-                }
-                // Initialize a container for the resultant matrix element [i][i]
-                std::vector<CompositeElement> res;
-
-                // Initialize the element by taking the first two elements from store and put it into res
-                res.push_back(CompositeElement(store[0], store[1], std::plus<int>(), '+'));
-                
-                // Pull from res, create a new element with the next one from store,
-                // clear res and push back to res
-                for (unsigned int l = 2; l < n; l++)
-                {
-                    CompositeElement e{ res[0] };
-                    res.clear();
-                    res.push_back(CompositeElement(e, store[l], std::plus<int>(), '+'));
+                    std::unique_ptr<Element> term{ new CompositeElement(*elements[i][k], *rhs.elements[k][j], std::multiplies<int>(), '*') };
+                    if (sum)
+                        sum.reset(new CompositeElement(std::move(sum), std::move(term), std::plus<int>(), '+'));
+                    else
+                        sum = std::move(term);
                 }
-                
+
                 // Push the element to a row
-                row.push_back(std::move(res[0].clone()));
+                row.push_back(std::move(sum));
             }
             // Push the row to elements
             m.elements.push_back(std::move(row));
@@ -750,4 +980,563 @@ ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::operator *(const Elem
 
         return m;
     }
-}
\ No newline at end of file
+}
+template<typename Type>
+std::vector<long long> ElementarySquareMatrix<Type>::values() const
+{
+    if (typeid(Type) == typeid(IntElement))
+        return std::vector<long long>(cells.begin(), cells.end());
+
+    std::vector<long long> vals;
+    vals.reserve(n * n);
+    Valuation v;
+    for (const auto& row : elements)
+    {
+        for (const auto& c : row)
+            vals.push_back(c->evaluate(v));
+    }
+
+    return vals;
+}
+
+template<typename Type>
+SmallVector<long long, ElementarySquareMatrix<Type>::inlineCells> ElementarySquareMatrix<Type>::wideCells() const
+{
+    SmallVector<long long, inlineCells> vals(cells.size());
+    std::copy(cells.begin(), cells.end(), vals.data());
+    return vals;
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::fromValues(unsigned int size, const std::vector<long long>& vals)
+{
+    return fromBuffer(size, vals.data());
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::fromBuffer(unsigned int size, const long long* vals)
+{
+    ElementarySquareMatrix<Type> m;
+    m.n = size;
+    if (typeid(Type) == typeid(IntElement))
+    {
+        m.cells.resize(static_cast<std::size_t>(size) * size);
+        for (std::size_t i = 0; i < m.cells.size(); i++)
+            m.cells[i] = static_cast<int>(vals[i]);
+        return m;
+    }
+
+    for (unsigned int i = 0; i < size; i++)
+    {
+        std::vector<std::unique_ptr<Element>> row;
+        for (unsigned int j = 0; j < size; j++)
+        {
+            row.push_back(std::unique_ptr<Element>(new IntElement{ static_cast<int>(vals[i * size + j]) }));
+        }
+        m.elements.push_back(std::move(row));
+    }
+
+    return m;
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::reduced(int modulus) const
+{
+    // Keep the result non-negative like the concrete kernels do
+    auto mod = [](int a, int b) { return ((a % b) + b) % b; };
+    IntElement eMod{ modulus };
+
+    ElementarySquareMatrix<Type> m;
+    m.n = n;
+    for (const auto& i : elements)
+    {
+        std::vector<std::unique_ptr<Element>> row;
+        for (const auto& j : i)
+        {
+            row.push_back(std::move(CompositeElement(*j, eMod, mod, '%').clone()));
+        }
+        m.elements.push_back(std::move(row));
+    }
+
+    return m;
+}
+
+template<typename Type>
+long long ElementarySquareMatrix<Type>::determinant() const
+{
+    // Symbolic matrices have no values to eliminate, see symbolicDeterminant()
+    if (typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    std::vector<long long> a = values();
+    return bareissKernel(a.data(), n);
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::kron(const ElementarySquareMatrix<Type>& a, const ElementarySquareMatrix<Type>& b)
+{
+    const unsigned int an = a.n;
+    const unsigned int bn = b.n;
+    const unsigned int size = an * bn;
+
+    ElementarySquareMatrix<Type> m;
+    m.n = size;
+    if (typeid(Type) == typeid(IntElement))
+    {
+        // The extreme products come from the extreme values, so one check covers every cell
+        if (size > 0)
+        {
+            const auto ra = std::minmax_element(a.cells.begin(), a.cells.end());
+            const auto rb = std::minmax_element(b.cells.begin(), b.cells.end());
+            const long long ends[4] = { 1LL * *ra.first * *rb.first, 1LL * *ra.first * *rb.second,
+                                        1LL * *ra.second * *rb.first, 1LL * *ra.second * *rb.second };
+            if (*std::min_element(ends, ends + 4) < INT_MIN || *std::max_element(ends, ends + 4) > INT_MAX)
+                throw std::overflow_error("Arithmetic overflow");
+        }
+
+        // Row r of the result is row r / bn of a scaling row r % bn of b
+        m.cells.resize(static_cast<std::size_t>(size) * size);
+        int* out = m.cells.data();
+        parallelRangeKernel(size, m.cells.size(), [&](unsigned int lo, unsigned int hi)
+        {
+            for (unsigned int r = lo; r < hi; r++)
+            {
+                const int* aRow = a.cells.data() + (r / bn) * an;
+                const int* bRow = b.cells.data() + (r % bn) * bn;
+                int* dst = out + static_cast<std::size_t>(r) * size;
+                for (unsigned int i = 0; i < an; i++, dst += bn)
+                    for (unsigned int k = 0; k < bn; k++)
+                        dst[k] = aRow[i] * bRow[k];
+            }
+        });
+        return m;
+    }
+
+    m.elements.resize(size);
+    parallelRangeKernel(size, static_cast<std::size_t>(size) * size, [&](unsigned int lo, unsigned int hi)
+    {
+        for (unsigned int r = lo; r < hi; r++)
+        {
+            std::vector<std::unique_ptr<Element>>& row = m.elements[r];
+            row.reserve(size);
+            for (unsigned int i = 0; i < an; i++)
+                for (unsigned int k = 0; k < bn; k++)
+                    row.push_back(CompositeElement(*a.elements[r / bn][i], *b.elements[r % bn][k], std::multiplies<int>(), '*').clone());
+        }
+    });
+    return m;
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::blockAssemble(const std::vector<std::vector<std::reference_wrapper<const ElementarySquareMatrix<Type>>>>& blocks)
+{
+    // Square blocks only tile a square matrix when the grid is square and the blocks share one size
+    const unsigned int grid = static_cast<unsigned int>(blocks.size());
+    const unsigned int bn = (grid && !blocks[0].empty()) ? blocks[0][0].get().n : 0;
+    for (const auto& blockRow : blocks)
+    {
+        if (blockRow.size() != grid)
+            throw std::invalid_argument("Incompatible matrices");
+        for (const auto& block : blockRow)
+            if (block.get().n != bn)
+                throw std::invalid_argument("Incompatible matrices");
+    }
+
+    const unsigned int size = grid * bn;
+    ElementarySquareMatrix<Type> m;
+    m.n = size;
+    if (typeid(Type) == typeid(IntElement))
+    {
+        // Each result row is a run of block rows copied side by side
+        m.cells.resize(static_cast<std::size_t>(size) * size);
+        int* out = m.cells.data();
+        parallelRangeKernel(size, m.cells.size(), [&](unsigned int lo, unsigned int hi)
+        {
+            for (unsigned int r = lo; r < hi; r++)
+            {
+                int* dst = out + static_cast<std::size_t>(r) * size;
+                for (const auto& block : blocks[r / bn])
+                {
+                    const int* src = block.get().cells.data() + (r % bn) * bn;
+                    dst = std::copy(src, src + bn, dst);
+                }
+            }
+        });
+        return m;
+    }
+
+    m.elements.resize(size);
+    parallelRangeKernel(size, static_cast<std::size_t>(size) * size, [&](unsigned int lo, unsigned int hi)
+    {
+        for (unsigned int r = lo; r < hi; r++)
+        {
+            std::vector<std::unique_ptr<Element>>& row = m.elements[r];
+            row.reserve(size);
+            for (const auto& block : blocks[r / bn])
+                for (const auto& e : block.get().elements[r % bn])
+                    row.push_back(e->clone());
+        }
+    });
+    return m;
+}
+
+template<typename Type>
+long long ElementarySquareMatrix<Type>::trace() const
+{
+    if (typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    long long sum = 0;
+    for (unsigned int i = 0; i < n; i++)
+        sum += cells[i * n + i];
+    return sum;
+}
+
+template<typename Type>
+unsigned int ElementarySquareMatrix<Type>::rank() const
+{
+    if (typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Halved log2 of the squared row and column norms, largest first.
+    // The nonzero ones also bound the rank from above.
+    std::vector<long double> rowBits(n, 0);
+    std::vector<long double> colBits(n, 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        for (unsigned int j = 0; j < n; j++)
+        {
+            const long double x = cells[i * n + j];
+            rowBits[i] += x * x;
+            colBits[j] += x * x;
+        }
+    }
+    const auto nonzero = [](const std::vector<long double>& norms)
+    {
+        return static_cast<unsigned int>(std::count_if(norms.begin(), norms.end(), [](long double x) { return x > 0; }));
+    };
+    const unsigned int limit = std::min(nonzero(rowBits), nonzero(colBits));
+    for (std::vector<long double>* norms : { &rowBits, &colBits })
+    {
+        for (long double& x : *norms)
+            x = x > 1 ? std::log2(x) / 2 : 0;
+        std::sort(norms->begin(), norms->end(), std::greater<long double>());
+    }
+
+    // Hadamard's bound in bits on the r x r minors, from the r largest row or column norms
+    const auto minorBits = [&rowBits, &colBits](unsigned int r)
+    {
+        return std::min(std::accumulate(rowBits.begin(), rowBits.begin() + r, 0.0L),
+            std::accumulate(colBits.begin(), colBits.begin() + r, 0.0L));
+    };
+
+    // The rank modulo p never exceeds the rank. If every prime so far gave at most best
+    // while the rank is larger, each of them divides every (best + 1) x (best + 1) minor,
+    // one of which is nonzero. Once the product of the primes exceeds the bound on those
+    // minors, not all of them can have missed the rank, so best is the rank.
+    std::vector<unsigned long long> a(cells.size());
+    unsigned int best = 0;
+    long double covered = 0;
+    unsigned int p = 2147483647u;
+    while (best < limit && covered <= minorBits(best + 1))
+    {
+        p = previousPrime(p);
+        const BarrettReducer red{ p };
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            // Shifting by 2^31 * p keeps the value nonnegative without changing it modulo p
+            a[i] = red.reduce(static_cast<unsigned long long>(cells[i] + (1LL << 31) * p));
+        }
+        best = std::max(best, rankModKernel(a.data(), n, p));
+        covered += std::log2(static_cast<long double>(p));
+        p--;
+    }
+
+    return best;
+}
+
+template<typename Type>
+std::vector<long long> ElementarySquareMatrix<Type>::characteristicPolynomial() const
+{
+    if (typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    std::vector<long long> a = values();
+    return berkowitzKernel(a.data(), n);
+}
+
+template<typename Type>
+std::unique_ptr<Element> ElementarySquareMatrix<Type>::symbolicDeterminant() const
+{
+    if (typeid(Type) == typeid(IntElement))
+    {
+        const long long det = determinant();
+        if (det < INT_MIN || det > INT_MAX)
+            throw std::overflow_error("Arithmetic overflow");
+        return IntElement{ static_cast<int>(det) }.clone();
+    }
+
+    if (n > symbolicDeterminantLimit)
+        throw std::invalid_argument("Matrix too large");
+
+    std::vector<unsigned int> cols(n);
+    for (unsigned int j = 0; j < n; j++)
+        cols[j] = j;
+    return cofactorExpansion(0, cols);
+}
+
+template<typename Type>
+std::unique_ptr<Element> ElementarySquareMatrix<Type>::cofactorExpansion(unsigned int row, std::vector<unsigned int>& cols) const
+{
+    // The determinant of the empty minor is 1
+    if (cols.empty())
+        return IntElement{ 1 }.clone();
+    if (cols.size() == 1)
+        return elements[row][cols[0]]->clone();
+
+    // The expansion grows factorially, so zero elements are skipped with their minors
+    std::unique_ptr<Element> sum;
+    for (unsigned int c = 0; c < cols.size(); c++)
+    {
+        const Element& e = *elements[row][cols[c]];
+        const IntElement* ie = dynamic_cast<const IntElement*>(&e);
+        if (ie && ie->getVal() == 0)
+            continue;
+
+        const unsigned int col = cols[c];
+        cols.erase(cols.begin() + c);
+        std::unique_ptr<Element> minor = cofactorExpansion(row + 1, cols);
+        cols.insert(cols.begin() + c, col);
+        const IntElement* im = dynamic_cast<const IntElement*>(minor.get());
+        if (im && im->getVal() == 0)
+            continue;
+
+        // The minor and the running sum are moved into the new nodes, only the element is copied
+        std::unique_ptr<Element> term{ new CompositeElement(e.clone(), std::move(minor), std::multiplies<int>(), '*') };
+        if (!sum)
+            sum = (c % 2 == 0) ? std::move(term) : std::unique_ptr<Element>{ new CompositeElement(IntElement{ 0 }.clone(), std::move(term), std::minus<int>(), '-') };
+        else if (c % 2 == 0)
+            sum.reset(new CompositeElement(std::move(sum), std::move(term), std::plus<int>(), '+'));
+        else
+            sum.reset(new CompositeElement(std::move(sum), std::move(term), std::minus<int>(), '-'));
+    }
+
+    return sum ? std::move(sum) : IntElement{ 0 }.clone();
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::power(unsigned int k, int modulus, const std::atomic<bool>* cancelled) const
+{
+    if (modulus < 0)
+        throw std::invalid_argument("Invalid modulus");
+
+    if (typeid(Type) == typeid(IntElement))
+    {
+        // Three buffers are enough for the whole exponentiation
+        std::vector<long long> vals = values();
+        if (!modulus)
+        {
+            // Without a modulus every product is checked, a wrapped 64-bit sum could look valid
+            std::vector<long long> res(vals.size());
+            std::vector<long long> tmp(vals.size());
+            checkedPowerKernel(vals, res, tmp, n, k, cancelled);
+            return fromValues(n, res);
+        }
+
+        for (auto& x : vals)
+            x = ((x % modulus) + modulus) % modulus;
+        std::vector<unsigned long long> base(vals.begin(), vals.end());
+        std::vector<unsigned long long> res(base.size());
+        std::vector<unsigned long long> tmp(base.size());
+        powerKernel<unsigned long long>(base, res, tmp, n, k, modulus, cancelled);
+
+        vals.assign(res.begin(), res.end());
+        return fromValues(n, vals);
+    }
+
+    else
+    {
+        // Symbolic elements cannot be multiplied in place, so build the
+        // expression by squaring and reduce after every product when asked
+        std::vector<long long> id(n * n, 0);
+        for (unsigned int i = 0; i < n; i++)
+            id[i * n + i] = (modulus == 1) ? 0 : 1;
+        ElementarySquareMatrix<Type> res = fromValues(n, id);
+        ElementarySquareMatrix<Type> base = modulus ? reduced(modulus) : ElementarySquareMatrix<Type>{ *this };
+
+        bool first = true;
+        while (k > 0)
+        {
+            if (cancelled && cancelled->load(std::memory_order_relaxed))
+                throw std::runtime_error("Operation cancelled");
+
+            if (k & 1)
+            {
+                // Multiplying the identity would only add "(1*x)" noise to the expression
+                res = first ? ElementarySquareMatrix<Type>{ base } : (modulus ? res.multiply(base, cancelled).reduced(modulus) : res.multiply(base, cancelled));
+                first = false;
+            }
+            k >>= 1;
+            if (k > 0)
+                base = modulus ? base.multiply(base, cancelled).reduced(modulus) : base.multiply(base, cancelled);
+        }
+
+        return res;
+    }
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::multiplyStrassen(const ElementarySquareMatrix<Type>& rhs, unsigned int crossover) const
+{
+    // Check dimensions and type
+    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Unsigned buffers make the wrap-around of the intermediate sums well defined,
+    // the low bits of the result are then the same as in the classical product
+    std::vector<long long> lhsVals = values();
+    std::vector<long long> rhsVals = rhs.values();
+    std::vector<long long> res(lhsVals.size());
+
+    // The result is exact in 64 bits only while the bound on the dot products fits
+    if (productFitsKernel(view(), rhs.view()))
+    {
+        std::vector<unsigned long long> a(lhsVals.begin(), lhsVals.end());
+        std::vector<unsigned long long> b(rhsVals.begin(), rhsVals.end());
+        std::vector<unsigned long long> c(a.size());
+        strassenKernel(a.data(), b.data(), c.data(), n, crossover);
+        res.assign(c.begin(), c.end());
+        narrowKernel(res.data(), res.size(), ArithmeticPolicy::Widening);
+    }
+
+    else
+    {
+        std::vector<unsigned __int128> a(lhsVals.begin(), lhsVals.end());
+        std::vector<unsigned __int128> b(rhsVals.begin(), rhsVals.end());
+        std::vector<unsigned __int128> c(a.size());
+        strassenKernel(a.data(), b.data(), c.data(), n, crossover);
+        narrowWideKernel(c.data(), res.data(), res.size(), ArithmeticPolicy::Widening);
+    }
+    return fromValues(n, res);
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::add(const ElementarySquareMatrix<Type>& rhs, ArithmeticPolicy policy) const
+{
+    // Check dimensions and type
+    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Sums of two ints always fit into 64 bits, only the narrowing can overflow.
+    // The scratch buffers are inline for small matrices, so those never allocate.
+    SmallVector<long long, inlineCells> a = wideCells();
+    SmallVector<long long, inlineCells> b = rhs.wideCells();
+    addKernel(a.data(), b.data(), a.size());
+    narrowKernel(a.data(), a.size(), policy);
+
+    return fromBuffer(n, a.data());
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::subtract(const ElementarySquareMatrix<Type>& rhs, ArithmeticPolicy policy) const
+{
+    // Check dimensions and type
+    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Differences of two ints always fit into 64 bits, only the narrowing can overflow
+    SmallVector<long long, inlineCells> a = wideCells();
+    SmallVector<long long, inlineCells> b = rhs.wideCells();
+    subtractKernel(a.data(), b.data(), a.size());
+    narrowKernel(a.data(), a.size(), policy);
+
+    return fromBuffer(n, a.data());
+}
+
+template<typename Type>
+ElementarySquareMatrix<Type> ElementarySquareMatrix<Type>::multiply(const ElementarySquareMatrix<Type>& rhs, ArithmeticPolicy policy,
+    const std::atomic<bool>* cancelled) const
+{
+    // Check dimensions and type
+    if (this->n != rhs.n || typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    // The kernels read the int cells in place, only the result needs a wider buffer
+    SmallVector<long long, inlineCells> c(cells.size());
+    policyMultiplyKernel(view(), rhs.view(), c.data(), policy, strassenThreshold, cancelled);
+
+    return fromBuffer(n, c.data());
+}
+
+template<typename Type>
+MatrixView<int> ElementarySquareMatrix<Type>::view() const
+{
+    // Only concrete matrices have values to look at
+    if (typeid(Type) != typeid(IntElement))
+        throw std::invalid_argument("Incompatible matrices");
+
+    return MatrixView<int>(cells.data(), n, n, n, 1);
+}
+
+template<typename Type>
+MatrixView<int> ElementarySquareMatrix<Type>::transposedView() const
+{
+    return view().transposed();
+}
+
+/**
+    \brief Operator for addition of two square views
+    \param lhs reference to a MatrixView object that is the left hand side of the addition
+    \param rhs reference to a MatrixView object that is the right hand side of the addition
+    \return ConcreteSquareMatrix object that is the result of the addition
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline ConcreteSquareMatrix operator +(const MatrixView<int>& lhs, const MatrixView<int>& rhs)
+{
+    if (lhs.rows() != lhs.cols() || lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+        throw std::invalid_argument("Incompatible matrices");
+
+    std::vector<long long> c(lhs.rows() * lhs.cols());
+    addViewKernel(lhs, rhs, c.data(), 1);
+    narrowKernel(c.data(), c.size(), ArithmeticPolicy::Widening);
+    return ConcreteSquareMatrix::fromValues(lhs.rows(), c);
+}
+
+/**
+    \brief Operator for subtraction of two square views
+    \param lhs reference to a MatrixView object that is the left hand side of the subtraction
+    \param rhs reference to a MatrixView object that is the right hand side of the subtraction
+    \return ConcreteSquareMatrix object that is the result of the subtraction
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline ConcreteSquareMatrix operator -(const MatrixView<int>& lhs, const MatrixView<int>& rhs)
+{
+    if (lhs.rows() != lhs.cols() || lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+        throw std::invalid_argument("Incompatible matrices");
+
+    std::vector<long long> c(lhs.rows() * lhs.cols());
+    addViewKernel(lhs, rhs, c.data(), -1);
+    narrowKernel(c.data(), c.size(), ArithmeticPolicy::Widening);
+    return ConcreteSquareMatrix::fromValues(lhs.rows(), c);
+}
+
+/**
+    \brief Operator for multiplication of two views whose product is square
+    \param lhs reference to a MatrixView object that is the left hand side of the multiplication
+    \param rhs reference to a MatrixView object that is the right hand side of the multiplication
+    \return ConcreteSquareMatrix object that is the result of the multiplication
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline ConcreteSquareMatrix operator *(const MatrixView<int>& lhs, const MatrixView<int>& rhs)
+{
+    if (lhs.cols() != rhs.rows() || lhs.rows() != rhs.cols())
+        throw std::invalid_argument("Incompatible matrices");
+
+    // The kernels follow the strides of the views, so transposed and block views are read in place
+    std::vector<long long> c(static_cast<std::size_t>(lhs.rows()) * rhs.cols());
+    policyMultiplyKernel(lhs, rhs, c.data(), ArithmeticPolicy::Widening, ConcreteSquareMatrix::strassenThreshold);
+    return ConcreteSquareMatrix::fromValues(lhs.rows(), c);
+}
@@ -226,6 +226,8 @@ TEST_CASE("ConcreteSquareMatrix move assignment operator test", "[ConcreteSquare
     m5 = std::move(m1);
     CHECK(m5.toString() == "[[3,-1,4][-7,-2,-1][6,0,1]]");
     CHECK(m1.toString() == "[[]]");
+    CHECK(m1.getN() == 0);
+    CHECK(m1.trace() == 0);
 }
 
 TEST_CASE("ConcreteSquareMatrix assignment operator test", "[ConcreteSquareMatrix]")
@@ -265,6 +267,39 @@ TEST_CASE("ConcreteSquareMatrix transpose method test", "[ConcreteSquareMatrix]"
     CHECK(m1.transpose().toString() == "[[3,-7,6][-1,-2,0][4,-1,1]]");
 }
 
+TEST_CASE("ConcreteSquareMatrix transposeInPlace method test", "[ConcreteSquareMatrix]")
+{
+    // Sizes below, at and around multiples of the transpose tile
+    for (unsigned int n : { 0u, 1u, 2u, 15u, 16u, 17u, 33u, 50u })
+    {
+        std::vector<long long> vals(n * n);
+        std::vector<long long> valsT(n * n);
+        for (unsigned int i = 0; i < n; i++)
+        {
+            for (unsigned int j = 0; j < n; j++)
+            {
+                vals[i * n + j] = i * 100 + j;
+                valsT[j * n + i] = i * 100 + j;
+            }
+        }
+        ConcreteSquareMatrix m = ConcreteSquareMatrix::fromValues(n, vals);
+        ConcreteSquareMatrix mT = ConcreteSquareMatrix::fromValues(n, valsT);
+        CHECK(m.transpose() == mT);
+        CHECK(m.transposeInPlace() == mT);
+        CHECK(m.transposeInPlace().values() == vals);
+    }
+}
+
+TEST_CASE("SymbolicSquareMatrix transposeInPlace method test", "[SymbolicSquareMatrix]")
+{
+    SymbolicSquareMatrix m{ "[[x,3,a][2,v,b][c,d,4]]" };
+    SymbolicSquareMatrix p = m * m;
+    CHECK(m.transposeInPlace().toString() == "[[x,2,c][3,v,d][a,b,4]]");
+    CHECK(p.transpose().transpose() == p);
+    SymbolicSquareMatrix pT = p.transpose();
+    CHECK(p.transposeInPlace() == pT);
+}
+
 TEST_CASE("ConcreteSquareMatrix default constructor test", "[ConcreteSquareMatrix]")
 {
     ConcreteSquareMatrix m0;
@@ -284,6 +319,328 @@ TEST_CASE("ConcreteSquareMatrix move constructor test", "[ConcreteSquareMatrix]"
     ConcreteSquareMatrix m5{ std::move(m1) };
     CHECK(m5.toString() == "[[3,-1,4][-7,-2,-1][6,0,1]]");
     CHECK(m1.toString() == "[[]]");
+
+    // The moved-from matrix is empty, so nothing reads its released cells
+    CHECK(m1.getN() == 0);
+    CHECK(m1.values().empty());
+    CHECK(m1.trace() == 0);
+}
+
+TEST_CASE("ConcreteSquareMatrix power method test", "[ConcreteSquareMatrix]")
+{
+    ConcreteSquareMatrix fib{ "[[1,1][1,0]]" };
+    CHECK(fib.power(0).toString() == "[[1,0][0,1]]");
+    CHECK(fib.power(1).toString() == "[[1,1][1,0]]");
+    CHECK(fib.power(10).toString() == "[[89,55][55,34]]");
+    CHECK(fib.power(10, 7).toString() == "[[5,6][6,6]]");
+    CHECK(fib.power(0, 1).toString() == "[[0,0][0,0]]");
+    ConcreteSquareMatrix m1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    CHECK(m1.power(3) == m1 * m1 * m1);
+    CHECK(m1.power(3, 5).toString() == "[[4,2,3][2,1,0][4,3,2]]");
+    ConcreteSquareMatrix m2{ "[[]]" };
+    CHECK(m2.power(5).toString() == "[[]]");
+    CHECK_THROWS_AS(m1.power(2, -3), std::invalid_argument);
+    CHECK_THROWS_WITH(m1.power(2, -3), "Invalid modulus");
+
+    // Intermediate products outside the int range throw even when the 64-bit result wraps to zero
+    ConcreteSquareMatrix two{ "[[2]]" };
+    CHECK(two.power(30).toString() == "[[1073741824]]");
+    CHECK_THROWS_AS(two.power(31), std::overflow_error);
+    CHECK_THROWS_WITH(two.power(64), "Arithmetic overflow");
+    ConcreteSquareMatrix big{ "[[65536,0][0,65536]]" };
+    CHECK_THROWS_AS(big.power(4), std::overflow_error);
+    CHECK(big.power(4, 7).toString() == "[[2,0][0,2]]");
+}
+
+TEST_CASE("ConcreteSquareMatrix multiplyStrassen method test", "[ConcreteSquareMatrix]")
+{
+    // Deterministic n x n matrices with mixed signs
+    auto build = [](unsigned int n, int seed)
+    {
+        std::string str = "[";
+        for (unsigned int i = 0; i < n; i++)
+        {
+            str.push_back('[');
+            for (unsigned int j = 0; j < n; j++)
+            {
+                str.append(std::to_string(static_cast<int>((i * 31 + j * 17 + seed) % 19) - 9));
+                str.push_back(',');
+            }
+            str.back() = ']';
+        }
+        str.push_back(']');
+        return str;
+    };
+
+    ConcreteSquareMatrix m1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ConcreteSquareMatrix m2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    CHECK(m1.multiplyStrassen(m2, 1).toString() == "[[-16,-30,-9][33,3,8][-30,-7,-12]]");
+    CHECK(m1.multiplyStrassen(m2).toString() == "[[-16,-30,-9][33,3,8][-30,-7,-12]]");
+
+    for (unsigned int n : { 16u, 37u })
+    {
+        ConcreteSquareMatrix a{ build(n, 3) };
+        ConcreteSquareMatrix b{ build(n, 11) };
+        ConcreteSquareMatrix classical = a * b;
+        CHECK(a.multiplyStrassen(b, 1) == classical);
+        CHECK(a.multiplyStrassen(b, 4) == classical);
+        CHECK(a.multiplyStrassen(b, 5) == classical);
+    }
+
+    // Intermediate sums outside 64 bits must not pass as valid results
+    ConcreteSquareMatrix min4 = ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, INT_MIN));
+    CHECK_THROWS_WITH(min4.multiplyStrassen(min4, 1), "Arithmetic overflow");
+    ConcreteSquareMatrix wide1{ "[[-2147483648,1][0,1]]" };
+    ConcreteSquareMatrix wide2{ "[[1,0][0,-2147483648]]" };
+    CHECK(wide1.multiplyStrassen(wide2, 1).toString() == "[[-2147483648,-2147483648][0,-2147483648]]");
+
+    ConcreteSquareMatrix m3{ "[[3,-1][-7,-2]]" };
+    CHECK_THROWS_AS(m1.multiplyStrassen(m3), std::invalid_argument);
+    CHECK_THROWS_WITH(m1.multiplyStrassen(m3), "Incompatible matrices");
+}
+
+TEST_CASE("ConcreteSquareMatrix arithmetic policy test", "[ConcreteSquareMatrix]")
+{
+    ConcreteSquareMatrix big{ "[[2147483647,1][-2147483648,0]]" };
+    ConcreteSquareMatrix one{ "[[1,1][1,1]]" };
+    CHECK_THROWS_AS(big + one, std::overflow_error);
+    CHECK_THROWS_WITH(big += one, "Arithmetic overflow");
+    CHECK(big.add(one, ArithmeticPolicy::Saturating).toString() == "[[2147483647,2][-2147483647,1]]");
+    CHECK(big.add(one, ArithmeticPolicy::Wrapping).toString() == "[[-2147483648,2][-2147483647,1]]");
+    CHECK(big.subtract(one, ArithmeticPolicy::Saturating).toString() == "[[2147483646,0][-2147483648,-1]]");
+    CHECK_THROWS_AS(big.subtract(one, ArithmeticPolicy::Checked), std::overflow_error);
+    CHECK(big.multiply(one, ArithmeticPolicy::Saturating).toString() == "[[2147483647,2147483647][-2147483648,-2147483648]]");
+    CHECK_THROWS_AS(big * one, std::overflow_error);
+
+    // The 64-bit accumulator itself overflows: 2 * 2^62 = 2^63
+    ConcreteSquareMatrix min{ "[[-2147483648,-2147483648][-2147483648,-2147483648]]" };
+    CHECK_THROWS_WITH(min.multiply(min, ArithmeticPolicy::Checked), "Arithmetic overflow");
+    CHECK_THROWS_WITH(min.multiply(min, ArithmeticPolicy::Widening), "Arithmetic overflow");
+    CHECK(min.multiply(min, ArithmeticPolicy::Saturating).toString() == "[[2147483647,2147483647][2147483647,2147483647]]");
+
+    // 4 * 2^62 = 2^64 wraps to exactly 0 in 64 bits
+    ConcreteSquareMatrix min4 = ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, INT_MIN));
+    CHECK_THROWS_AS(min4 * min4, std::overflow_error);
+    CHECK_THROWS_WITH(min4.multiply(min4, ArithmeticPolicy::Widening), "Arithmetic overflow");
+    CHECK(min4.multiply(min4, ArithmeticPolicy::Saturating) == ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, INT_MAX)));
+    CHECK(min4.multiply(min4, ArithmeticPolicy::Wrapping) == ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, 0)));
+
+    ConcreteSquareMatrix m1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ConcreteSquareMatrix m2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    for (auto policy : { ArithmeticPolicy::Wrapping, ArithmeticPolicy::Widening, ArithmeticPolicy::Saturating, ArithmeticPolicy::Checked })
+    {
+        CHECK(m1.add(m2, policy).toString() == "[[-2,-1,2][-6,0,2][6,-7,1]]");
+        CHECK(m1.subtract(m2, policy).toString() == "[[8,-1,6][-8,-4,-4][6,7,1]]");
+        CHECK(m1.multiply(m2, policy).toString() == "[[-16,-30,-9][33,3,8][-30,-7,-12]]");
+    }
+    ConcreteSquareMatrix m3{ "[[3,-1][-7,-2]]" };
+    CHECK_THROWS_WITH(m1.multiply(m3, ArithmeticPolicy::Checked), "Incompatible matrices");
+}
+
+TEST_CASE("SymbolicSquareMatrix power method test", "[SymbolicSquareMatrix]")
+{
+    SymbolicSquareMatrix m{ "[[x,1][1,0]]" };
+    Valuation v;
+    v['x'] = 1;
+    CHECK(m.power(0).toString() == "[[1,0][0,1]]");
+    CHECK(m.power(1).toString() == "[[x,1][1,0]]");
+    CHECK(m.power(2).toString() == "[[((x*x)+(1*1)),((x*1)+(1*0))][((1*x)+(0*1)),((1*1)+(0*0))]]");
+    CHECK(m.power(10).evaluate(v).toString() == "[[89,55][55,34]]");
+    CHECK(m.power(10, 7).evaluate(v).toString() == "[[5,6][6,6]]");
+    SymbolicSquareMatrix m1{ "[[y]]" };
+    v['y'] = -3;
+    CHECK(m1.power(3).evaluate(v).toString() == "[[-27]]");
+    CHECK(m1.power(3, 5).evaluate(v).toString() == "[[3]]");
+}
+
+TEST_CASE("ConcreteSquareMatrix inline storage threshold test", "[ConcreteSquareMatrix]")
+{
+    // 8 x 8 fits into the inline cells, 9 x 9 moves to the heap
+    for (unsigned int n : { 8u, 9u })
+    {
+        std::string str = "[";
+        std::string strT = "[";
+        for (unsigned int i = 0; i < n; i++)
+        {
+            str.push_back('[');
+            strT.push_back('[');
+            for (unsigned int j = 0; j < n; j++)
+            {
+                str.append(std::to_string(i * n + j) + ",");
+                strT.append(std::to_string(j * n + i) + ",");
+            }
+            str.back() = ']';
+            strT.back() = ']';
+        }
+        str.push_back(']');
+        strT.push_back(']');
+
+        ConcreteSquareMatrix m{ str };
+        CHECK(m.toString() == str);
+        CHECK(m.transpose().toString() == strT);
+        ConcreteSquareMatrix copy{ m };
+        CHECK(copy == m);
+        ConcreteSquareMatrix moved{ std::move(copy) };
+        CHECK(moved == m);
+        CHECK(copy.toString() == "[[]]");
+        CHECK((m - moved).power(2) == ConcreteSquareMatrix::fromValues(n, std::vector<long long>(n * n, 0)));
+    }
+}
+
+TEST_CASE("ConcreteSquareMatrix determinant method test", "[ConcreteSquareMatrix]")
+{
+    CHECK(ConcreteSquareMatrix{ "[[3,-1,4][-7,-2,-1][6,0,1]]" }.determinant() == 41);
+    CHECK(ConcreteSquareMatrix{ "[[0,1][1,0]]" }.determinant() == -1);
+    CHECK(ConcreteSquareMatrix{ "[[0,0,2][0,3,0][5,0,0]]" }.determinant() == -30);
+    CHECK(ConcreteSquareMatrix{ "[[1,2][2,4]]" }.determinant() == 0);
+    CHECK(ConcreteSquareMatrix{ "[[0,0][0,0]]" }.determinant() == 0);
+    CHECK(ConcreteSquareMatrix{ "[[-7]]" }.determinant() == -7);
+    CHECK(ConcreteSquareMatrix{ "[]" }.determinant() == 1);
+
+    // Minors larger than int are kept exactly
+    CHECK(ConcreteSquareMatrix{ "[[100000,0][0,100000]]" }.determinant() == 10000000000LL);
+    CHECK_THROWS_AS((ConcreteSquareMatrix{ "[[2147483647,0,0][0,2147483647,0][0,0,2147483647]]" }.determinant()), std::overflow_error);
+    CHECK_THROWS_WITH(SymbolicSquareMatrix{ "[[x]]" }.determinant(), "Incompatible matrices");
+
+    // The n x n tridiagonal matrix with 2 on the diagonal and -1 next to it has determinant n + 1,
+    // large enough to cross several column tiles
+    const unsigned int n = 300;
+    std::vector<long long> vals(n * n, 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        vals[i * n + i] = 2;
+        if (i + 1 < n)
+            vals[i * n + i + 1] = vals[(i + 1) * n + i] = -1;
+    }
+    CHECK(ConcreteSquareMatrix::fromValues(n, vals).determinant() == n + 1);
+}
+
+TEST_CASE("SymbolicSquareMatrix symbolicDeterminant method test", "[SymbolicSquareMatrix]")
+{
+    Valuation v;
+    v['a'] = 1;
+    v['b'] = 2;
+    v['c'] = 3;
+    v['d'] = 4;
+    SymbolicSquareMatrix m{ "[[a,b][c,d]]" };
+    CHECK(m.symbolicDeterminant()->toString() == "((a*d)-(b*c))");
+    CHECK(m.symbolicDeterminant()->evaluate(v) == -2);
+
+    SymbolicSquareMatrix m3{ "[[a,0,b][c,2,0][1,d,a]]" };
+    CHECK(m3.symbolicDeterminant()->evaluate(v) == m3.evaluate(v).determinant());
+    CHECK(SymbolicSquareMatrix{ "[[0,a][0,b]]" }.symbolicDeterminant()->toString() == "0");
+    CHECK(SymbolicSquareMatrix{ "[]" }.symbolicDeterminant()->toString() == "1");
+    CHECK(ConcreteSquareMatrix{ "[[3,-1][-7,-2]]" }.symbolicDeterminant()->toString() == "-13");
+
+    // Only symbolic matrices are limited, concrete ones use the Bareiss elimination
+    const unsigned int limit = SymbolicSquareMatrix::symbolicDeterminantLimit;
+    std::vector<long long> id(static_cast<std::size_t>(limit + 1) * (limit + 1), 0);
+    for (unsigned int i = 0; i <= limit; i++)
+        id[i * (limit + 1) + i] = 1;
+    CHECK_THROWS_WITH(SymbolicSquareMatrix::fromValues(limit + 1, id).symbolicDeterminant(), "Matrix too large");
+    CHECK(ConcreteSquareMatrix::fromValues(limit + 1, id).symbolicDeterminant()->toString() == "1");
+}
+
+TEST_CASE("ConcreteSquareMatrix trace, rank and characteristicPolynomial methods test", "[ConcreteSquareMatrix]")
+{
+    ConcreteSquareMatrix m{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    CHECK(m.trace() == 2);
+    CHECK(ConcreteSquareMatrix{ "[[2147483647,0][0,2147483647]]" }.trace() == 4294967294LL);
+    CHECK(ConcreteSquareMatrix{ "[]" }.trace() == 0);
+
+    CHECK(m.rank() == 3);
+    CHECK(ConcreteSquareMatrix{ "[[1,2,3][4,5,6][7,8,9]]" }.rank() == 2);
+    CHECK(ConcreteSquareMatrix{ "[[1,2][2,4]]" }.rank() == 1);
+    CHECK(ConcreteSquareMatrix{ "[[0,0][0,0]]" }.rank() == 0);
+    CHECK(ConcreteSquareMatrix{ "[[0,5][0,0]]" }.rank() == 1);
+    CHECK(ConcreteSquareMatrix{ "[]" }.rank() == 0);
+    // Singular modulo the first prime tried, but not over the integers
+    CHECK(ConcreteSquareMatrix{ "[[2147483647,0][0,1]]" }.rank() == 2);
+    CHECK(ConcreteSquareMatrix{ "[[-2147483648,2147483647,0][0,0,0][1,-1,0]]" }.rank() == 2);
+
+    // Rank 5 from the product of a 40 x 5 and a 5 x 40 factor with large entries
+    std::vector<long long> lowRank(40 * 40);
+    for (unsigned int i = 0; i < 40; i++)
+        for (unsigned int j = 0; j < 40; j++)
+            for (unsigned int k = 0; k < 5; k++)
+                lowRank[i * 40 + j] += static_cast<long long>((i * 7 + k * 13) % 19 + 1) * ((j * 11 + k * 5) % 23 + 1) * 100000;
+    CHECK(ConcreteSquareMatrix::fromValues(40, lowRank).rank() == 5);
+
+    CHECK(m.characteristicPolynomial() == std::vector<long long>{ 1, -2, -36, -41 });
+    CHECK(ConcreteSquareMatrix{ "[[2,1][1,2]]" }.characteristicPolynomial() == std::vector<long long>{ 1, -4, 3 });
+    CHECK(ConcreteSquareMatrix{ "[[0,1][0,0]]" }.characteristicPolynomial() == std::vector<long long>{ 1, 0, 0 });
+    CHECK(ConcreteSquareMatrix{ "[[-7]]" }.characteristicPolynomial() == std::vector<long long>{ 1, 7 });
+    CHECK(ConcreteSquareMatrix{ "[]" }.characteristicPolynomial() == std::vector<long long>{ 1 });
+
+    // The constant term is (-1)^n det(A) and the second coefficient is -trace(A)
+    ConcreteSquareMatrix m6{ "[[1,2,0,-1,3,1][0,4,1,2,-2,0][5,-1,2,0,1,1][2,0,-3,1,0,4][1,1,1,1,1,1][0,-2,3,1,2,-1]]" };
+    std::vector<long long> c = m6.characteristicPolynomial();
+    CHECK(c.size() == 7);
+    CHECK(c[1] == -m6.trace());
+    CHECK(c[6] == m6.determinant());
+
+    SymbolicSquareMatrix s{ "[[x]]" };
+    CHECK_THROWS_WITH(s.trace(), "Incompatible matrices");
+    CHECK_THROWS_WITH(s.rank(), "Incompatible matrices");
+    CHECK_THROWS_WITH(s.characteristicPolynomial(), "Incompatible matrices");
+}
+
+TEST_CASE("ElementarySquareMatrix kron and blockAssemble methods test", "[ConcreteSquareMatrix]")
+{
+    ConcreteSquareMatrix a{ "[[1,2][3,4]]" };
+    ConcreteSquareMatrix b{ "[[0,5][6,7]]" };
+    CHECK(kron(a, b).toString() == "[[0,5,0,10][6,7,12,14][0,15,0,20][18,21,24,28]]");
+    CHECK(kron(ConcreteSquareMatrix{ "[[2]]" }, b).toString() == "[[0,10][12,14]]");
+    CHECK(kron(a, ConcreteSquareMatrix{ "[]" }).toString() == "[[]]");
+    CHECK_THROWS_AS(kron(ConcreteSquareMatrix{ "[[65536]]" }, ConcreteSquareMatrix{ "[[-65536]]" }), std::overflow_error);
+    CHECK(kron(ConcreteSquareMatrix{ "[[65536]]" }, ConcreteSquareMatrix{ "[[-32768]]" }).toString() == "[[-2147483648]]");
+
+    CHECK(ConcreteSquareMatrix::blockAssemble({ { a, b }, { b, a } }).toString() == "[[1,2,0,5][3,4,6,7][0,5,1,2][6,7,3,4]]");
+    CHECK(ConcreteSquareMatrix::blockAssemble({ { a } }) == a);
+    CHECK(ConcreteSquareMatrix::blockAssemble({}).toString() == "[[]]");
+    CHECK_THROWS_WITH(ConcreteSquareMatrix::blockAssemble({ { a, b } }), "Incompatible matrices");
+    ConcreteSquareMatrix one{ "[[1]]" };
+    CHECK_THROWS_WITH(ConcreteSquareMatrix::blockAssemble({ { a, b }, { b, one } }), "Incompatible matrices");
+
+    SymbolicSquareMatrix s{ "[[x,1][0,y]]" };
+    SymbolicSquareMatrix t{ "[[2]]" };
+    CHECK(kron(s, t).toString() == "[[(x*2),(1*2)][(0*2),(y*2)]]");
+    CHECK(SymbolicSquareMatrix::blockAssemble({ { s, s }, { s, s } }).toString() == "[[x,1,x,1][0,y,0,y][x,1,x,1][0,y,0,y]]");
+
+    // Large enough to be split across threads
+    std::vector<long long> vals(64 * 64);
+    for (std::size_t i = 0; i < vals.size(); i++)
+        vals[i] = static_cast<long long>(i % 13) - 6;
+    ConcreteSquareMatrix big = ConcreteSquareMatrix::fromValues(64, vals);
+    ConcreteSquareMatrix b4{ "[[1,0,2,0][0,-1,0,3][4,0,0,1][0,0,5,-2]]" };
+    ConcreteSquareMatrix k = kron(big, b4);
+    CHECK(k.getN() == 256);
+    std::vector<long long> kv = k.values();
+    std::vector<long long> bv = b4.values();
+    unsigned int mismatches = 0;
+    for (unsigned int r = 0; r < 256; r++)
+        for (unsigned int c = 0; c < 256; c++)
+            if (kv[r * 256 + c] != vals[(r / 4) * 64 + c / 4] * bv[(r % 4) * 4 + c % 4])
+                mismatches++;
+    CHECK(mismatches == 0);
+    ConcreteSquareMatrix blocks = ConcreteSquareMatrix::blockAssemble({ { big, big, big, big }, { big, big, big, big }, { big, big, big, big }, { big, big, big, big } });
+    CHECK(blocks.getN() == 256);
+    CHECK(blocks.values()[200 * 256 + 100] == vals[(200 % 64) * 64 + 100 % 64]);
+}
+
+TEST_CASE("ElementarySquareMatrix hash method test", "[ConcreteSquareMatrix]")
+{
+    ConcreteSquareMatrix a{ "[[1,2][3,4]]" };
+    ConcreteSquareMatrix b{ "[[1,2][3,4]]" };
+    CHECK(a.hash() == b.hash());
+    CHECK(a.hash() != ConcreteSquareMatrix{ "[[2,1][3,4]]" }.hash());
+    CHECK(a.hash() != a.transpose().hash());
+    CHECK(ConcreteSquareMatrix{ "[[0]]" }.hash() != ConcreteSquareMatrix{ "[]" }.hash());
+
+    SymbolicSquareMatrix s{ "[[x,1][0,y]]" };
+    CHECK(s.hash() == SymbolicSquareMatrix{ "[[x,1][0,y]]" }.hash());
+    CHECK(s.hash() != SymbolicSquareMatrix{ "[[y,1][0,x]]" }.hash());
+    CHECK((s * s).hash() == (s * s).hash());
 }
 
 TEST_CASE("isSquareMatrix test", "[isSquareMatrix]") {
@@ -364,4 +721,4 @@ TEST_CASE("isSymbolicSquareMatrix test", "[isSymbolicSquareMatrix]")
     CHECK(!isSymbolicSquareMatrix("[[1,2][2]]"));
     CHECK(!isSymbolicSquareMatrix("[[,2][2,1]"));
     CHECK(!isSymbolicSquareMatrix("[[--]]"));
-}
\ No newline at end of file
+}
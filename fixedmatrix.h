@@ -0,0 +1,238 @@
+/**
+    \file fixedmatrix.h
+    \brief Header for the FixedSquareMatrix class template
+*/
+
+#pragma once
+
+#include "numericmatrix.h"
+#include <array>
+#include <string>
+#include <utility>
+#include <stdexcept>
+
+/**
+    \class FixedSquareMatrix
+    \brief Defines a class for a matrix whose size is known at compile time
+    \tparam T scalar type of the matrix
+    \tparam N size of the matrix
+
+    The values live inline in a std::array, so the matrix never allocates.
+    The arithmetic is constexpr and every loop is unrolled with index
+    sequences, which suits the 2 x 2, 3 x 3 and 4 x 4 transforms.
+*/
+template<typename T, unsigned int N> class FixedSquareMatrix
+{
+public:
+    /**
+        \brief Default constructor, all values are zero
+        \tparam T scalar type of the matrix
+        \tparam N size of the matrix
+    */
+    constexpr FixedSquareMatrix() : vals{} {}
+
+    /**
+        \brief Parametric constructor
+        \param v array of the N * N values in row-major order
+        \tparam T scalar type of the matrix
+        \tparam N size of the matrix
+    */
+    constexpr FixedSquareMatrix(const std::array<T, N * N>& v) : vals(v) {}
+
+    /**
+        \brief Parametric constructor
+        \param m reference to a ConcreteSquareMatrix object whose values are converted to T
+        \tparam T scalar type of the matrix
+        \tparam N size of the matrix
+        \exception std::invalid_argument Incompatible matrices
+    */
+    explicit FixedSquareMatrix(const ConcreteSquareMatrix& m) : FixedSquareMatrix(NumericSquareMatrix<T>{ m }) {}
+
+    /**
+        \brief Parametric constructor
+        \param m reference to a NumericSquareMatrix object
+        \tparam T scalar type of the matrix
+        \tparam N size of the matrix
+        \exception std::invalid_argument Incompatible matrices
+    */
+    explicit FixedSquareMatrix(const NumericSquareMatrix<T>& m)
+    {
+        if (m.getN() != N)
+            throw std::invalid_argument("Incompatible matrices");
+        std::copy(m.data().begin(), m.data().end(), vals.begin());
+    }
+
+    /**
+        \brief Method for creating the identity matrix
+        \return FixedSquareMatrix object that is the identity matrix
+    */
+    static constexpr FixedSquareMatrix identity()
+    {
+        return identityImpl(std::make_index_sequence<N * N>{});
+    }
+
+    /**
+        \brief Method for converting the matrix into a NumericSquareMatrix
+        \return NumericSquareMatrix object holding the values
+    */
+    NumericSquareMatrix<T> toNumeric() const
+    {
+        return NumericSquareMatrix<T>{ N, std::vector<T>(vals.begin(), vals.end()) };
+    }
+
+    /**
+        \brief Method for converting the matrix into a ConcreteSquareMatrix
+        \return ConcreteSquareMatrix object holding the values, floating point values are rounded
+        \exception std::overflow_error Arithmetic overflow
+    */
+    ConcreteSquareMatrix toConcrete() const { return toNumeric().toConcrete(); }
+
+    /**
+        \brief Method for creating a string representation of the matrix
+        \return string that is the string representation of the matrix
+    */
+    std::string toString() const { return toNumeric().toString(); }
+
+    /**
+        \brief Getter for the size n of the matrix
+        \return unsigned int value N
+    */
+    static constexpr unsigned int getN() { return N; }
+
+    /**
+        \brief Getter for a value of the matrix
+        \param i row index
+        \param j column index
+        \return T value at row i and column j
+    */
+    constexpr T at(unsigned int i, unsigned int j) const { return vals[i * N + j]; }
+
+    /**
+        \brief Method for creating a new matrix that is a transpose of the matrix
+        \return FixedSquareMatrix object that is the transpose of the matrix
+    */
+    constexpr FixedSquareMatrix transpose() const
+    {
+        return transposeImpl(*this, std::make_index_sequence<N * N>{});
+    }
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a FixedSquareMatrix object to compare to
+        \return Boolean value of the comparison
+    */
+    constexpr bool operator ==(const FixedSquareMatrix& rhs) const
+    {
+        return equalImpl(*this, rhs, std::make_index_sequence<N * N>{});
+    }
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a FixedSquareMatrix object that is the matrix to add
+        \return Reference to a FixedSquareMatrix object that is the result of the addition
+    */
+    constexpr FixedSquareMatrix& operator +=(const FixedSquareMatrix& rhs) { return *this = *this + rhs; }
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a FixedSquareMatrix object that is the matrix to subtract
+        \return Reference to a FixedSquareMatrix object that is the result of the subtraction
+    */
+    constexpr FixedSquareMatrix& operator -=(const FixedSquareMatrix& rhs) { return *this = *this - rhs; }
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a FixedSquareMatrix object that is the matrix to multiply with
+        \return Reference to a FixedSquareMatrix object that is the result of the multiplication
+    */
+    constexpr FixedSquareMatrix& operator *=(const FixedSquareMatrix& rhs) { return *this = *this * rhs; }
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a FixedSquareMatrix object that is the right hand side of the addition
+        \return FixedSquareMatrix object that is the result of the addition
+    */
+    constexpr FixedSquareMatrix operator +(const FixedSquareMatrix& rhs) const
+    {
+        return addImpl(*this, rhs, std::make_index_sequence<N * N>{});
+    }
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a FixedSquareMatrix object that is the right hand side of the subtraction
+        \return FixedSquareMatrix object that is the result of the subtraction
+    */
+    constexpr FixedSquareMatrix operator -(const FixedSquareMatrix& rhs) const
+    {
+        return subtractImpl(*this, rhs, std::make_index_sequence<N * N>{});
+    }
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a FixedSquareMatrix object that is the right hand side of the multiplication
+        \return FixedSquareMatrix object that is the result of the multiplication
+    */
+    constexpr FixedSquareMatrix operator *(const FixedSquareMatrix& rhs) const
+    {
+        return multiplyImpl(*this, rhs, std::make_index_sequence<N * N>{});
+    }
+
+private:
+    std::array<T, N * N> vals;
+
+    template<std::size_t... I>
+    static constexpr FixedSquareMatrix identityImpl(std::index_sequence<I...>)
+    {
+        return FixedSquareMatrix{ std::array<T, N * N>{ { T(I / N == I % N ? 1 : 0)... } } };
+    }
+
+    template<std::size_t... I>
+    static constexpr FixedSquareMatrix transposeImpl(const FixedSquareMatrix& a, std::index_sequence<I...>)
+    {
+        return FixedSquareMatrix{ std::array<T, N * N>{ { a.vals[(I % N) * N + I / N]... } } };
+    }
+
+    template<std::size_t... I>
+    static constexpr bool equalImpl(const FixedSquareMatrix& a, const FixedSquareMatrix& b, std::index_sequence<I...>)
+    {
+        return ((a.vals[I] == b.vals[I]) && ... && true);
+    }
+
+    template<std::size_t... I>
+    static constexpr FixedSquareMatrix addImpl(const FixedSquareMatrix& a, const FixedSquareMatrix& b, std::index_sequence<I...>)
+    {
+        return FixedSquareMatrix{ std::array<T, N * N>{ { T(a.vals[I] + b.vals[I])... } } };
+    }
+
+    template<std::size_t... I>
+    static constexpr FixedSquareMatrix subtractImpl(const FixedSquareMatrix& a, const FixedSquareMatrix& b, std::index_sequence<I...>)
+    {
+        return FixedSquareMatrix{ std::array<T, N * N>{ { T(a.vals[I] - b.vals[I])... } } };
+    }
+
+    // Value of the product at row i and column j, one term per k
+    template<std::size_t... K>
+    static constexpr T dot(const FixedSquareMatrix& a, const FixedSquareMatrix& b, std::size_t i, std::size_t j, std::index_sequence<K...>)
+    {
+        return (T(0) + ... + T(a.vals[i * N + K] * b.vals[K * N + j]));
+    }
+
+    template<std::size_t... I>
+    static constexpr FixedSquareMatrix multiplyImpl(const FixedSquareMatrix& a, const FixedSquareMatrix& b, std::index_sequence<I...>)
+    {
+        return FixedSquareMatrix{ std::array<T, N * N>{ { dot(a, b, I / N, I % N, std::make_index_sequence<N>{})... } } };
+    }
+};
+
+/**
+    \brief Operator for output
+    \param os stream to print in
+    \param m reference to a FixedSquareMatrix object
+    \tparam T scalar type of the matrix
+    \tparam N size of the matrix
+*/
+template<typename T, unsigned int N>
+std::ostream& operator <<(std::ostream& os, const FixedSquareMatrix<T, N>& m)
+{
+    return os << m.toString();
+}
@@ -0,0 +1,54 @@
+/**
+    \file fixedmatrix_tests.cpp
+    \brief Unit tests for the FixedSquareMatrix class template
+*/
+
+#include "catch.hpp"
+#include "fixedmatrix.h"
+
+TEST_CASE("FixedSquareMatrix constexpr arithmetic test", "[FixedSquareMatrix]")
+{
+    constexpr FixedSquareMatrix<int, 2> a{ std::array<int, 4>{ 1, 2, 3, 4 } };
+    constexpr FixedSquareMatrix<int, 2> b{ std::array<int, 4>{ 0, 1, -1, 5 } };
+
+    // Evaluated by the compiler
+    static_assert((a + b) == FixedSquareMatrix<int, 2>{ std::array<int, 4>{ 1, 3, 2, 9 } }, "constexpr addition");
+    static_assert((a - b) == FixedSquareMatrix<int, 2>{ std::array<int, 4>{ 1, 1, 4, -1 } }, "constexpr subtraction");
+    static_assert((a * b) == FixedSquareMatrix<int, 2>{ std::array<int, 4>{ -2, 11, -4, 23 } }, "constexpr multiplication");
+    static_assert(a.transpose() == FixedSquareMatrix<int, 2>{ std::array<int, 4>{ 1, 3, 2, 4 } }, "constexpr transpose");
+    static_assert(a * FixedSquareMatrix<int, 2>::identity() == a, "constexpr identity");
+    static_assert(FixedSquareMatrix<int, 2>::getN() == 2, "constexpr size");
+    static_assert(sizeof(FixedSquareMatrix<int, 4>) == 16 * sizeof(int), "inline storage");
+
+    FixedSquareMatrix<int, 2> c{ a };
+    c += b;
+    CHECK(c.toString() == "[[1,3][2,9]]");
+    c -= b;
+    CHECK(c == a);
+    c *= b;
+    CHECK(c.toString() == "[[-2,11][-4,23]]");
+    CHECK(c.at(1, 0) == -4);
+}
+
+TEST_CASE("FixedSquareMatrix matches ConcreteSquareMatrix test", "[FixedSquareMatrix]")
+{
+    ConcreteSquareMatrix m1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ConcreteSquareMatrix m2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    FixedSquareMatrix<int, 3> f1{ m1 };
+    FixedSquareMatrix<int, 3> f2{ m2 };
+    CHECK((f1 + f2).toConcrete() == m1 + m2);
+    CHECK((f1 - f2).toConcrete() == m1 - m2);
+    CHECK((f1 * f2).toConcrete() == m1 * m2);
+    CHECK(f1.transpose().toConcrete() == m1.transpose());
+    CHECK_THROWS_WITH((FixedSquareMatrix<int, 2>{ m1 }), "Incompatible matrices");
+}
+
+TEST_CASE("FixedSquareMatrix floating point test", "[FixedSquareMatrix]")
+{
+    FixedSquareMatrix<double, 4> m{ DoubleSquareMatrix{ "[[1,0,0,0.5][0,2,0,0][0,0,1,-1][0,0,0,1]]" } };
+    CHECK((m * FixedSquareMatrix<double, 4>::identity()) == m);
+    CHECK((m * m).toString() == "[[1,0,0,1][0,4,0,0][0,0,1,-2][0,0,0,1]]");
+    CHECK(m.toNumeric().transpose().toString() == m.transpose().toString());
+    FixedSquareMatrix<double, 0> empty;
+    CHECK((empty * empty).toString() == "[[]]");
+}
@@ -0,0 +1,113 @@
+/**
+    \file generator.cpp
+    \brief Command line interface of the workload generator
+*/
+
+#include "workload.h"
+#include <iostream>
+#include <string>
+#include <stdexcept>
+
+/**
+    \brief Function for printing the command line usage
+    \param name name of the program
+*/
+void usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options]" << std::endl
+        << "  --n size           size of the matrices, 3 by default" << std::endl
+        << "  --count count      number of matrices, 1 by default" << std::endl
+        << "  --sparsity f       fraction of zero elements" << std::endl
+        << "  --variables f      fraction of nonzero elements that are variables" << std::endl
+        << "  --alphabet letters lowercase letters of the variables, xyz by default" << std::endl
+        << "  --min value        smallest nonzero value, -9 by default" << std::endl
+        << "  --max value        largest nonzero value, 9 by default" << std::endl
+        << "  --seed seed        seed of the random numbers, 1 by default" << std::endl
+        << "  --binary           print the matrices in the binary form" << std::endl
+        << "  --rpn commands     print a calculator command stream of the given length instead" << std::endl
+        << "  --terms count      most pushed elements a stack entry of the stream is built from, 65536 by default" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    MatrixSpec spec;
+    unsigned long count = 1;
+    unsigned int seed = 1;
+    bool binary = false;
+    long rpn = -1;
+    CommandSpec commands;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--binary")
+            {
+                binary = true;
+                continue;
+            }
+            if (i + 1 >= argc)
+                throw std::invalid_argument(arg);
+
+            const std::string value = argv[++i];
+            if (arg == "--n")
+                spec.n = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--count")
+                count = std::stoul(value);
+            else if (arg == "--sparsity")
+                spec.sparsity = std::stod(value);
+            else if (arg == "--variables")
+                spec.variables = std::stod(value);
+            else if (arg == "--alphabet")
+                spec.alphabet = value;
+            else if (arg == "--min")
+                spec.minValue = std::stoi(value);
+            else if (arg == "--max")
+                spec.maxValue = std::stoi(value);
+            else if (arg == "--seed")
+                seed = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--rpn")
+                rpn = std::stol(value);
+            else if (arg == "--terms")
+                commands.maxTerms = std::stoull(value);
+            else
+                throw std::invalid_argument(arg);
+        }
+    }
+    catch (const std::exception&)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // The output is large, so stdio is not synchronized
+    std::ios::sync_with_stdio(false);
+    WorkloadGenerator gen{ seed };
+    try
+    {
+        if (rpn >= 0)
+        {
+            commands.commands = static_cast<unsigned int>(rpn);
+            commands.matrix = spec;
+            std::cout << gen.commands(commands);
+        }
+        else
+        {
+            for (unsigned long i = 0; i < count; i++)
+            {
+                if (binary)
+                    std::cout << gen.binaryMatrix(spec);
+                else
+                    std::cout << gen.matrix(spec) << '\n';
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
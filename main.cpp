@@ -3,152 +3,142 @@
 	\brief Implementation of the Matrix calculator user interface
 */
 
-#define CATCH_CONFIG_RUNNER
-
-#include "element.h"
-#include "compositeelement.h"
-#include "elementarymatrix.h"
-#include "catch.hpp"
+#include "calculator.h"
+#include "server.h"
 #include <iostream>
+#include <fstream>
 #include <string>
-#include <stack>
-#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+#include <thread>
 
 /**
-	\brief Function for checking if a string is an integer
-	\param str string
-	\return Boolean value of the check
+	\brief Function for printing the command line usage
+	\param name name of the program
 */
-bool isInt(const std::string& str)
+void usage(const char* name)
 {
-	if (str.empty() || ((!isdigit(str[0])) && (str[0] != '-')))
-		return false;
+	std::cerr << "Usage: " << name << " [-b|--batch] [-q|--quiet] [script]" << std::endl
+		<< "       " << name << " (-s|--socket path | -p|--port port) [-w|--workers count]" << std::endl
+		<< "  -b, --batch    read commands without prompts, stdin when no script is given" << std::endl
+		<< "  -q, --quiet    print only the top of the stack at the end, implies --batch" << std::endl
+		<< "  -s, --socket   serve sessions on a Unix domain socket" << std::endl
+		<< "  -p, --port     serve sessions on a TCP port of the loopback interface, 0 to 65535" << std::endl
+		<< "  -w, --workers  number of sessions served at the same time, 1 to the number of hardware threads" << std::endl;
+}
 
-	char* p;
-	strtol(str.c_str(), &p, 10);
+/**
+	\brief Function for parsing a bounded unsigned command line value
+	\param str string to parse
+	\param lo smallest accepted value
+	\param hi largest accepted value
+	\param value reference receiving the parsed value
+	\return Boolean value telling whether str is a decimal number in [lo, hi]
+*/
+bool parseBounded(const std::string& str, unsigned long lo, unsigned long hi, unsigned long& value)
+{
+	// Signs are rejected here, std::stoul would turn "-1" into ULONG_MAX
+	if (str.empty() || str.size() > 9 || !std::all_of(str.begin(), str.end(), [](char c) { return c >= '0' && c <= '9'; }))
+		return false;
 
-	return (*p == 0);
+	value = std::stoul(str);
+	return value >= lo && value <= hi;
 }
 
 int main(int argc, char** argv)
 {
-	int result = Catch::Session().run(argc, argv);
+	bool batch = false;
+	bool quiet = false;
+	std::string script;
+	std::string socketPath;
+	bool portGiven = false;
+	unsigned long port = 0;
+	unsigned long workers = 0;
+	const unsigned long maxWorkers = std::max(std::thread::hardware_concurrency(), 1u);
 
-	std::stack<ElementarySquareMatrix<Element>> mystack;
-	std::vector<ElementarySquareMatrix<Element>> mystore;
-	Valuation v;
-	std::string inp = "0";
-	std::string delim = "=";
-	
-	while (inp != "quit")
+	for (int i = 1; i < argc; i++)
 	{
-		std::cout << ">";
-		std::cin >> inp;
-		if (isSymbolicSquareMatrix(inp))
-			mystack.push(SymbolicSquareMatrix{inp});
-
-		// Adding variable values
-		else if (inp[1] == '=' && isalpha(inp[0]) && isInt(inp.substr(inp.find("=") + 1)))
+		std::string arg = argv[i];
+		if (arg == "-b" || arg == "--batch")
+			batch = true;
+		else if (arg == "-q" || arg == "--quiet")
+			batch = quiet = true;
+		else if ((arg == "-s" || arg == "--socket") && i + 1 < argc)
+			socketPath = argv[++i];
+		else if ((arg == "-p" || arg == "--port") && i + 1 < argc && parseBounded(argv[i + 1], 0, 65535, port))
 		{
-			int val = std::stoi(inp.substr(inp.find("=") + 1));
-			v[inp[0]] = val;
+			portGiven = true;
+			i++;
 		}
-
-		// Addition
-		else if (inp == "+")
+		else if ((arg == "-w" || arg == "--workers") && i + 1 < argc && parseBounded(argv[i + 1], 1, maxWorkers, workers))
+			i++;
+		else if (script.empty() && (arg == "-" || arg[0] != '-'))
+			script = arg;
+		else
 		{
-			// Check that stack has enough operands
-			if (mystack.size() > 1)
-			{
-				mystore.push_back(mystack.top());
-				mystack.pop();
-				mystore.push_back(mystack.top());
-				mystack.pop();
-				// Check that operands have equal dimensions
-				if (mystore[0].getN() != mystore[1].getN())
-				{
-					std::cout << "Operation could not be executed" << std::endl;
-					mystack.push(mystore[1]);
-					mystack.push(mystore[0]);
-					mystore.clear();
-				}
-				else
-				{
-					mystack.push(mystore[0] + mystore[1]);
-					std::cout << mystack.top() << std::endl;
-					mystore.clear();
-				}
-			}
-			else std::cout << "Operation could not be executed" << std::endl;
+			usage(argv[0]);
+			return 1;
 		}
+	}
 
-		// Subtraction
-		else if (inp == "-")
+	// Server mode runs until the process is ended
+	if (!socketPath.empty() || portGiven)
+	{
+		if (batch || !script.empty() || (!socketPath.empty() && portGiven))
 		{
-			// Check that stack has enough operands
-			if (mystack.size() > 1)
-			{
-				mystore.push_back(mystack.top());
-				mystack.pop();
-				mystore.push_back(mystack.top());
-				mystack.pop();
-				// Check that operands have equal dimensions
-				if (mystore[0].getN() != mystore[1].getN())
-				{
-					std::cout << "Operation could not be executed" << std::endl;
-					mystack.push(mystore[1]);
-					mystack.push(mystore[0]);
-					mystore.clear();
-				}
-				else
-				{
-					mystack.push(mystore[0] - mystore[1]);
-					std::cout << mystack.top() << std::endl;
-					mystore.clear();
-				}
-			}
-			else std::cout << "Operation could not be executed" << std::endl;
+			usage(argv[0]);
+			return 1;
 		}
 
-		// Multiplication
-		else if (inp == "*")
+		try
 		{
-			// Check that stack has enough operands
-			if (mystack.size() > 1)
+			const unsigned int count = static_cast<unsigned int>(workers);
+			if (!socketPath.empty())
+			{
+				CalculatorServer server{ socketPath, count };
+				server.serve();
+			}
+			else
 			{
-				mystore.push_back(mystack.top());
-				mystack.pop();
-				mystore.push_back(mystack.top());
-				mystack.pop();
-				// Check that operands have equal dimensions
-				if (mystore[0].getN() != mystore[1].getN())
-				{
-					std::cout << "Operation could not be executed" << std::endl;
-					mystack.push(mystore[1]);
-					mystack.push(mystore[0]);
-					mystore.clear();
-				}
-				else
-				{
-					mystack.push(mystore[0] * mystore[1]);
-					std::cout << mystack.top() << std::endl;
-					mystore.clear();
-				}
+				CalculatorServer server{ static_cast<unsigned short>(port), count };
+				server.serve();
 			}
-			else std::cout << "Operation could not be executed" << std::endl;
 		}
-
-		// Evaluating the top matrix from stack
-		else if (inp == "=")
+		catch (const std::exception& e)
 		{
-			if (!mystack.empty())
-				std::cout << mystack.top().evaluate(v) << std::endl;
-			else std::cout << "Operation could not be executed" << std::endl;
+			std::cerr << e.what() << std::endl;
+			return 1;
 		}
+		return 0;
+	}
 
-		else if (inp == "quit") {}
+	// A script runs in batch mode
+	if (!script.empty())
+		batch = true;
 
-		else std::cout << "Invalid input" << std::endl;
+	if (!batch)
+	{
+		Calculator calc{ std::cout };
+		calc.run(std::cin);
+		return 0;
+	}
+
+	// Batch mode leaves the buffering to the streams, so stdio is not synchronized
+	std::ios::sync_with_stdio(false);
+	std::cin.tie(nullptr);
+
+	Calculator calc{ std::cout, false, quiet };
+	if (script.empty() || script == "-")
+		calc.run(std::cin);
+	else
+	{
+		std::ifstream file{ script };
+		if (!file)
+		{
+			std::cerr << "Cannot open " << script << std::endl;
+			return 1;
+		}
+		calc.run(file);
 	}
 
 	return 0;
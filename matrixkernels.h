@@ -0,0 +1,1289 @@
+/**
+    \file matrixkernels.h
+    \brief Header for the row-major buffer kernels used by the concrete matrix operations
+*/
+
+#pragma once
+
+#include "smallvector.h"
+#include "matrixview.h"
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <future>
+#include <thread>
+#include <atomic>
+
+/**
+    \brief Policies for handling integer overflow in the concrete matrix arithmetic
+
+    Products accumulate in 64 bits while their size bound allows it and in
+    128 bits otherwise, so every policy but Checked sees the exact result.
+    The policies differ in how it is narrowed back into the int values of
+    IntElement.
+*/
+enum class ArithmeticPolicy
+{
+    Wrapping,   ///< Keep the low 32 bits like two's complement int arithmetic would
+    Widening,   ///< Throw std::overflow_error if a result does not fit into an int
+    Saturating, ///< Clamp results into [INT_MIN, INT_MAX]
+    Checked     ///< Like Widening, but also throw if any 64-bit accumulation step overflows
+};
+
+/**
+    \brief Function for checking a cancellation flag
+    \param cancelled optional flag, nullptr for none
+    \exception std::runtime_error Operation cancelled
+*/
+inline void cancellationKernel(const std::atomic<bool>* cancelled)
+{
+    if (cancelled && cancelled->load(std::memory_order_relaxed))
+        throw std::runtime_error("Operation cancelled");
+}
+
+/**
+    \brief Function for adding two buffers element by element
+    \param a pointer to the left hand side buffer, receives the result
+    \param b pointer to the right hand side buffer
+    \param count number of values in the buffers
+    \tparam T scalar type of the buffers
+*/
+template<typename T>
+void addKernel(T* a, const T* b, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+        a[i] += b[i];
+}
+
+/**
+    \brief Function for subtracting two buffers element by element
+    \param a pointer to the left hand side buffer, receives the result
+    \param b pointer to the right hand side buffer
+    \param count number of values in the buffers
+    \tparam T scalar type of the buffers
+*/
+template<typename T>
+void subtractKernel(T* a, const T* b, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+        a[i] -= b[i];
+}
+
+/**
+    \brief Edge length of the tiles at which the recursive transpose kernels stop splitting
+*/
+const unsigned int transposeTileSize = 16;
+
+/**
+    \brief Function for transposing one full tile of a row-major buffer
+    \param src pointer to the source buffer
+    \param dst pointer to the destination buffer
+    \param n size of the matrices
+    \param r0 first row of the tile
+    \param c0 first column of the tile
+    \tparam T scalar type of the buffers
+    \tparam Tile edge length of the tile
+
+    The bounds are compile-time constants, so the compiler unrolls the tile
+    and vectorizes the gathers for the width of T.
+*/
+template<typename T, unsigned int Tile>
+void transposeTile(const T* src, T* dst, unsigned int n, unsigned int r0, unsigned int c0)
+{
+    for (unsigned int i = 0; i < Tile; i++)
+    {
+        for (unsigned int j = 0; j < Tile; j++)
+            dst[(c0 + j) * n + r0 + i] = src[(r0 + i) * n + c0 + j];
+    }
+}
+
+/**
+    \brief Function for the position at which a recursive kernel splits a range
+    \param size length of the range
+    \return offset of the split, a multiple of transposeTileSize
+*/
+inline unsigned int transposeSplit(unsigned int size)
+{
+    return std::max(transposeTileSize, (size / 2) / transposeTileSize * transposeTileSize);
+}
+
+/**
+    \brief Function for transposing a block of a row-major buffer into another buffer
+    \param src pointer to the source buffer
+    \param dst pointer to the destination buffer, must not alias src
+    \param n size of the matrices
+    \param r0 first row of the block
+    \param r1 one past the last row of the block
+    \param c0 first column of the block
+    \param c1 one past the last column of the block
+    \tparam T scalar type of the buffers
+*/
+template<typename T>
+void transposeBlock(const T* src, T* dst, unsigned int n, unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1)
+{
+    const unsigned int rows = r1 - r0;
+    const unsigned int cols = c1 - c0;
+
+    if (rows <= transposeTileSize && cols <= transposeTileSize)
+    {
+        if (rows == transposeTileSize && cols == transposeTileSize)
+            transposeTile<T, transposeTileSize>(src, dst, n, r0, c0);
+        else
+        {
+            for (unsigned int i = r0; i < r1; i++)
+            {
+                for (unsigned int j = c0; j < c1; j++)
+                    dst[j * n + i] = src[i * n + j];
+            }
+        }
+        return;
+    }
+
+    // Halve the longer side, so the blocks fit into every cache level at some depth
+    if (rows >= cols)
+    {
+        const unsigned int mid = r0 + transposeSplit(rows);
+        transposeBlock(src, dst, n, r0, mid, c0, c1);
+        transposeBlock(src, dst, n, mid, r1, c0, c1);
+    }
+    else
+    {
+        const unsigned int mid = c0 + transposeSplit(cols);
+        transposeBlock(src, dst, n, r0, r1, c0, mid);
+        transposeBlock(src, dst, n, r0, r1, mid, c1);
+    }
+}
+
+/**
+    \brief Function for transposing an n x n row-major buffer into another buffer with a cache-oblivious recursion
+    \param src pointer to the source buffer
+    \param dst pointer to the destination buffer, must not alias src
+    \param n size of the matrices
+    \tparam T scalar type of the buffers
+*/
+template<typename T>
+void transposeKernel(const T* src, T* dst, unsigned int n)
+{
+    transposeBlock(src, dst, n, 0, n, 0, n);
+}
+
+/**
+    \brief Function for swapping a block above the diagonal with its mirror image below the diagonal
+    \param r0 first row of the block
+    \param r1 one past the last row of the block
+    \param c0 first column of the block, r1 <= c0
+    \param c1 one past the last column of the block
+    \param swapCells callable swapping cell (i, j) with cell (j, i)
+    \tparam Swap type of the callable
+*/
+template<typename Swap>
+void transposeSwapBlock(unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1, Swap& swapCells)
+{
+    const unsigned int rows = r1 - r0;
+    const unsigned int cols = c1 - c0;
+
+    if (rows <= transposeTileSize && cols <= transposeTileSize)
+    {
+        for (unsigned int i = r0; i < r1; i++)
+        {
+            for (unsigned int j = c0; j < c1; j++)
+                swapCells(i, j);
+        }
+        return;
+    }
+
+    if (rows >= cols)
+    {
+        const unsigned int mid = r0 + transposeSplit(rows);
+        transposeSwapBlock(r0, mid, c0, c1, swapCells);
+        transposeSwapBlock(mid, r1, c0, c1, swapCells);
+    }
+    else
+    {
+        const unsigned int mid = c0 + transposeSplit(cols);
+        transposeSwapBlock(r0, r1, c0, mid, swapCells);
+        transposeSwapBlock(r0, r1, mid, c1, swapCells);
+    }
+}
+
+/**
+    \brief Function for transposing the diagonal block [lo, hi) x [lo, hi) of a square matrix in place
+    \param lo first row and column of the block
+    \param hi one past the last row and column of the block
+    \param swapCells callable swapping cell (i, j) with cell (j, i)
+    \tparam Swap type of the callable
+
+    The cells are only ever swapped, so the callable decides what a cell is:
+    a value of a buffer or a pointer to an element tree.
+*/
+template<typename Swap>
+void transposeInPlaceKernel(unsigned int lo, unsigned int hi, Swap& swapCells)
+{
+    if (hi - lo <= transposeTileSize)
+    {
+        for (unsigned int i = lo; i < hi; i++)
+        {
+            for (unsigned int j = i + 1; j < hi; j++)
+                swapCells(i, j);
+        }
+        return;
+    }
+
+    // Both diagonal blocks transpose on their own, the off-diagonal blocks trade places
+    const unsigned int mid = lo + transposeSplit(hi - lo);
+    transposeInPlaceKernel(lo, mid, swapCells);
+    transposeInPlaceKernel(mid, hi, swapCells);
+    transposeSwapBlock(lo, mid, mid, hi, swapCells);
+}
+
+/**
+    \brief Function for multiplying two n x n row-major buffers
+    \param a pointer to the left hand side buffer
+    \param b pointer to the right hand side buffer
+    \param c pointer to the result buffer, must not alias a or b
+    \param n size of the matrices
+    \param cancelled optional flag checked before every row, nullptr for none
+    \tparam T scalar type of the buffers
+    \exception std::runtime_error Operation cancelled
+*/
+template<typename T>
+void multiplyKernel(const T* a, const T* b, T* c, unsigned int n, const std::atomic<bool>* cancelled = nullptr)
+{
+    for (unsigned int i = 0; i < n * n; i++)
+        c[i] = 0;
+
+    // i-k-j order so that the innermost loop walks both b and c contiguously
+    for (unsigned int i = 0; i < n; i++)
+    {
+        cancellationKernel(cancelled);
+        for (unsigned int k = 0; k < n; k++)
+        {
+            const T aik = a[i * n + k];
+            for (unsigned int j = 0; j < n; j++)
+                c[i * n + j] += aik * b[k * n + j];
+        }
+    }
+}
+
+/**
+    \brief Function for multiplying two strided views tile by tile into a row-major buffer
+    \param a reference to the rows x inner left hand side view
+    \param b reference to the inner x cols right hand side view
+    \param c pointer to the rows x cols result buffer, must not alias a or b
+    \param ldc distance between two rows of c in values
+    \param block edge length of the square tiles
+    \param cancelled optional flag checked before every row of tiles, nullptr for none
+    \tparam T scalar type of the result buffer, the products are accumulated in it
+    \tparam S scalar type of the views
+    \exception std::runtime_error Operation cancelled
+
+    The views are read in place through their strides. When the columns of
+    b are contiguous the tiles run in the i-k-j order of multiplyKernel,
+    when its rows are, as in a transposed view, every value of c is a dot
+    product along the contiguous runs of b.
+*/
+template<typename T, typename S>
+void blockedMultiplyKernel(const MatrixView<S>& a, const MatrixView<S>& b, T* c, std::size_t ldc, unsigned int block = 64,
+    const std::atomic<bool>* cancelled = nullptr)
+{
+    const unsigned int rows = a.rows();
+    const unsigned int inner = a.cols();
+    const unsigned int cols = b.cols();
+    const std::ptrdiff_t ars = a.rowStride();
+    const std::ptrdiff_t acs = a.colStride();
+    const std::ptrdiff_t brs = b.rowStride();
+    const std::ptrdiff_t bcs = b.colStride();
+    const bool dot = bcs != 1 && brs == 1;
+
+    for (unsigned int i = 0; i < rows; i++)
+        std::fill(c + i * ldc, c + i * ldc + cols, T(0));
+
+    // Work on tiles that fit into the cache, inside them the same i-k-j order as multiplyKernel
+    for (unsigned int ii = 0; ii < rows; ii += block)
+    {
+        cancellationKernel(cancelled);
+        const unsigned int iEnd = std::min(ii + block, rows);
+        for (unsigned int kk = 0; kk < inner; kk += block)
+        {
+            const unsigned int kEnd = std::min(kk + block, inner);
+            for (unsigned int jj = 0; jj < cols; jj += block)
+            {
+                const unsigned int jEnd = std::min(jj + block, cols);
+                for (unsigned int i = ii; i < iEnd; i++)
+                {
+                    T* cRow = c + i * ldc;
+                    const S* aRow = a.data() + i * ars;
+                    if (dot)
+                    {
+                        for (unsigned int j = jj; j < jEnd; j++)
+                        {
+                            const S* bCol = b.data() + j * bcs;
+                            T sum = cRow[j];
+                            for (unsigned int k = kk; k < kEnd; k++)
+                                sum += static_cast<T>(aRow[k * acs]) * static_cast<T>(bCol[k]);
+                            cRow[j] = sum;
+                        }
+                        continue;
+                    }
+
+                    for (unsigned int k = kk; k < kEnd; k++)
+                    {
+                        const T aik = static_cast<T>(aRow[k * acs]);
+                        const S* bRow = b.data() + k * brs;
+                        if (bcs == 1)
+                        {
+                            for (unsigned int j = jj; j < jEnd; j++)
+                                cRow[j] += aik * static_cast<T>(bRow[j]);
+                        }
+                        else
+                        {
+                            for (unsigned int j = jj; j < jEnd; j++)
+                                cRow[j] += aik * static_cast<T>(bRow[j * bcs]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+    \brief Function for multiplying two n x n row-major buffers tile by tile
+    \param a pointer to the left hand side buffer
+    \param b pointer to the right hand side buffer
+    \param c pointer to the result buffer, must not alias a or b
+    \param n size of the matrices
+    \param block edge length of the square tiles
+    \tparam T scalar type of the buffers
+*/
+template<typename T>
+void blockedMultiplyKernel(const T* a, const T* b, T* c, unsigned int n, unsigned int block = 64)
+{
+    blockedMultiplyKernel(MatrixView<T>(a, n, n, n, 1), MatrixView<T>(b, n, n, n, 1), c, n, block);
+}
+
+/**
+    \brief Function for adding or subtracting two h x h blocks of row-major buffers
+    \param dst pointer to the first value of the result block, may alias x or y
+    \param ldd distance between two rows of dst in values
+    \param x pointer to the first value of the left hand side block
+    \param ldx distance between two rows of x in values
+    \param y pointer to the first value of the right hand side block
+    \param ldy distance between two rows of y in values
+    \param h size of the blocks
+    \param subtract whether to compute x - y instead of x + y
+    \tparam T scalar type of the buffers
+*/
+template<typename T>
+void strassenCombineKernel(T* dst, std::size_t ldd, const T* x, std::size_t ldx, const T* y, std::size_t ldy, unsigned int h, bool subtract)
+{
+    for (unsigned int i = 0; i < h; i++)
+    {
+        T* d = dst + i * ldd;
+        const T* xr = x + i * ldx;
+        const T* yr = y + i * ldy;
+        if (subtract)
+        {
+            for (unsigned int j = 0; j < h; j++)
+                d[j] = xr[j] - yr[j];
+        }
+        else
+        {
+            for (unsigned int j = 0; j < h; j++)
+                d[j] = xr[j] + yr[j];
+        }
+    }
+}
+
+/**
+    \brief Function for the number of scratch values strassenStep needs for a given size
+    \param n size of the matrices
+    \param crossover size at and below which the blocked classical kernel is used
+    \return size_t value of the workspace length over all recursion levels
+*/
+inline std::size_t strassenWorkspaceKernel(unsigned int n, unsigned int crossover)
+{
+    std::size_t total = 0;
+    while (n > crossover && n % 2 == 0)
+    {
+        n /= 2;
+        total += 2 * static_cast<std::size_t>(n) * n;
+    }
+    return total;
+}
+
+/**
+    \brief Function for one recursion step of the Strassen-Winograd multiplication
+    \param a pointer to the left hand side block
+    \param lda distance between two rows of a in values
+    \param b pointer to the right hand side block
+    \param ldb distance between two rows of b in values
+    \param c pointer to the result block, must not alias a or b
+    \param ldc distance between two rows of c in values
+    \param n size of the blocks, a multiple of two whenever n > crossover
+    \param crossover size at and below which the blocked classical kernel is used
+    \param work pointer to strassenWorkspaceKernel(n, crossover) scratch values
+    \param cancelled optional flag checked by the classical products, nullptr for none
+    \tparam T scalar type of the buffers
+    \exception std::runtime_error Operation cancelled
+
+    The quadrants are addressed in place through the leading dimensions.
+    Every level uses two h x h temporaries and works in the four quadrants
+    of c itself, following the schedule of Boyer, Dumas, Pernet and Zhou,
+    and passes the rest of the workspace on to the level below.
+*/
+template<typename T>
+void strassenStep(const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c, std::size_t ldc, unsigned int n,
+    unsigned int crossover, T* work, const std::atomic<bool>* cancelled = nullptr)
+{
+    if (n <= crossover || n % 2)
+    {
+        blockedMultiplyKernel(MatrixView<T>(a, n, n, lda, 1), MatrixView<T>(b, n, n, ldb, 1), c, ldc, 64, cancelled);
+        return;
+    }
+
+    const unsigned int h = n / 2;
+    const std::size_t hh = static_cast<std::size_t>(h) * h;
+
+    const T* a11 = a;               const T* a12 = a + h;
+    const T* a21 = a + h * lda;     const T* a22 = a21 + h;
+    const T* b11 = b;               const T* b12 = b + h;
+    const T* b21 = b + h * ldb;     const T* b22 = b21 + h;
+    T* c11 = c;                     T* c12 = c + h;
+    T* c21 = c + h * ldc;           T* c22 = c21 + h;
+    T* x = work;
+    T* y = work + hh;
+    T* next = work + 2 * hh;
+
+    // s3 * t3 = p7
+    strassenCombineKernel(x, h, a11, lda, a21, lda, h, true);
+    strassenCombineKernel(y, h, b22, ldb, b12, ldb, h, true);
+    strassenStep(x, h, y, h, c21, ldc, h, crossover, next, cancelled);
+
+    // s1 * t1 = p5
+    strassenCombineKernel(x, h, a21, lda, a22, lda, h, false);
+    strassenCombineKernel(y, h, b12, ldb, b11, ldb, h, true);
+    strassenStep(x, h, y, h, c22, ldc, h, crossover, next, cancelled);
+
+    // s2 * t2 = p6
+    strassenCombineKernel(x, h, x, h, a11, lda, h, true);
+    strassenCombineKernel(y, h, b22, ldb, y, h, h, true);
+    strassenStep(x, h, y, h, c12, ldc, h, crossover, next, cancelled);
+
+    // s4 * b22 = p3, then x is free for p1
+    strassenCombineKernel(x, h, a12, lda, x, h, h, true);
+    strassenStep(x, h, b22, ldb, c11, ldc, h, crossover, next, cancelled);
+    strassenStep(a11, lda, b11, ldb, x, h, h, crossover, next, cancelled);
+
+    // u2 = p1 + p6, u3 = u2 + p7, u4 = u2 + p5, c22 = u3 + p5, c12 = u4 + p3
+    strassenCombineKernel(c12, ldc, x, h, c12, ldc, h, false);
+    strassenCombineKernel(c21, ldc, c12, ldc, c21, ldc, h, false);
+    strassenCombineKernel(c12, ldc, c12, ldc, c22, ldc, h, false);
+    strassenCombineKernel(c22, ldc, c21, ldc, c22, ldc, h, false);
+    strassenCombineKernel(c12, ldc, c12, ldc, c11, ldc, h, false);
+
+    // c21 = u3 - a22 * t4
+    strassenCombineKernel(y, h, y, h, b21, ldb, h, true);
+    strassenStep(a22, lda, y, h, c11, ldc, h, crossover, next, cancelled);
+    strassenCombineKernel(c21, ldc, c21, ldc, c11, ldc, h, true);
+
+    // c11 = p1 + a12 * b21
+    strassenStep(a12, lda, b21, ldb, c11, ldc, h, crossover, next, cancelled);
+    strassenCombineKernel(c11, ldc, x, h, c11, ldc, h, false);
+}
+
+/**
+    \brief Function for multiplying two n x n row-major buffers with the Strassen-Winograd algorithm
+    \param a pointer to the left hand side buffer
+    \param b pointer to the right hand side buffer
+    \param c pointer to the result buffer, must not alias a or b
+    \param n size of the matrices
+    \param crossover size at and below which the blocked classical kernel is used
+    \param cancelled optional flag checked by the classical products, nullptr for none
+    \tparam T scalar type of the buffers
+    \exception std::runtime_error Operation cancelled
+
+    Sizes that do not halve evenly down to the crossover are zero padded once
+    at the top level, and the scratch space of all levels, about 2/3 n^2
+    values, is allocated once. The algorithm only uses ring operations, so
+    the result equals the classical product exactly for integer types. Use
+    an unsigned type to keep wrap-around of the intermediate sums well
+    defined. The result is then exact modulo 2^bits, so the caller must make
+    sure the true product fits, for example with productFitsKernel, or use
+    unsigned __int128, which holds every dot product of ints.
+*/
+template<typename T>
+void strassenKernel(const T* a, const T* b, T* c, unsigned int n, unsigned int crossover, const std::atomic<bool>* cancelled = nullptr)
+{
+    if (crossover == 0)
+        crossover = 1;
+
+    // Find the smallest size m * 2^levels >= n with m <= crossover
+    unsigned int m = n;
+    unsigned int levels = 0;
+    while (m > crossover)
+    {
+        m = (m + 1) / 2;
+        levels++;
+    }
+    const unsigned int padded = m << levels;
+    std::vector<T> work(strassenWorkspaceKernel(padded, crossover));
+
+    if (padded == n)
+    {
+        strassenStep(a, n, b, n, c, n, n, crossover, work.data(), cancelled);
+        return;
+    }
+
+    std::vector<T> pa(padded * padded, 0);
+    std::vector<T> pb(padded * padded, 0);
+    std::vector<T> pc(padded * padded);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        std::copy(a + i * n, a + (i + 1) * n, pa.begin() + i * padded);
+        std::copy(b + i * n, b + (i + 1) * n, pb.begin() + i * padded);
+    }
+    strassenStep(pa.data(), padded, pb.data(), padded, pc.data(), padded, padded, crossover, work.data(), cancelled);
+    for (unsigned int i = 0; i < n; i++)
+        std::copy(pc.begin() + i * padded, pc.begin() + i * padded + n, c + i * n);
+}
+
+/**
+    \brief Function for multiplying two strided views into a row-major buffer with overflow checks on the accumulator
+    \param a reference to the rows x inner left hand side view with values in the int range
+    \param b reference to the inner x cols right hand side view with values in the int range
+    \param c pointer to the rows x cols result buffer, must not alias a or b
+    \param cancelled optional flag checked before every row, nullptr for none
+    \return Boolean value telling whether any accumulation overflowed 64 bits
+    \tparam S scalar type of the views
+    \exception std::runtime_error Operation cancelled
+*/
+template<typename S>
+bool checkedMultiplyKernel(const MatrixView<S>& a, const MatrixView<S>& b, long long* c, const std::atomic<bool>* cancelled = nullptr)
+{
+    using U = unsigned long long;
+
+    const unsigned int rows = a.rows();
+    const unsigned int inner = a.cols();
+    const unsigned int cols = b.cols();
+    const std::ptrdiff_t bcs = b.colStride();
+    for (std::size_t i = 0; i < static_cast<std::size_t>(rows) * cols; i++)
+        c[i] = 0;
+
+    // Products of two ints always fit into 64 bits, so only the sums need checking.
+    // The sign test is branch free and keeps the inner loop vectorizable.
+    U overflow = 0;
+    const auto accumulate = [&overflow](long long& acc, U y)
+    {
+        const U x = static_cast<U>(acc);
+        const U sum = x + y;
+        overflow |= (sum ^ x) & (sum ^ y);
+        acc = static_cast<long long>(sum);
+    };
+    for (unsigned int i = 0; i < rows; i++)
+    {
+        cancellationKernel(cancelled);
+        long long* cRow = c + static_cast<std::size_t>(i) * cols;
+        for (unsigned int k = 0; k < inner; k++)
+        {
+            const U aik = static_cast<U>(static_cast<long long>(a(i, k)));
+            const S* bRow = b.data() + k * b.rowStride();
+            if (bcs == 1)
+            {
+                for (unsigned int j = 0; j < cols; j++)
+                    accumulate(cRow[j], aik * static_cast<U>(static_cast<long long>(bRow[j])));
+            }
+            else
+            {
+                for (unsigned int j = 0; j < cols; j++)
+                    accumulate(cRow[j], aik * static_cast<U>(static_cast<long long>(bRow[j * bcs])));
+            }
+        }
+    }
+
+    return (overflow >> 63) != 0;
+}
+
+/**
+    \brief Function for multiplying two n x n row-major buffers with overflow checks on the accumulator
+    \param a pointer to the left hand side buffer with values in the int range
+    \param b pointer to the right hand side buffer with values in the int range
+    \param c pointer to the result buffer, must not alias a or b
+    \param n size of the matrices
+    \param cancelled optional flag checked before every row, nullptr for none
+    \return Boolean value telling whether any accumulation overflowed 64 bits
+    \exception std::runtime_error Operation cancelled
+*/
+inline bool checkedMultiplyKernel(const long long* a, const long long* b, long long* c, unsigned int n, const std::atomic<bool>* cancelled = nullptr)
+{
+    return checkedMultiplyKernel(MatrixView<long long>(a, n, n, n, 1), MatrixView<long long>(b, n, n, n, 1), c, cancelled);
+}
+
+/**
+    \brief Function for adding a product to a 64-bit accumulator with overflow checks
+    \param acc reference to the accumulator, receives the sum
+    \param a left hand side of the product
+    \param b right hand side of the product
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline void checkedMultiplyAdd(long long& acc, long long a, long long b)
+{
+    long long prod;
+    if (__builtin_mul_overflow(a, b, &prod) || __builtin_add_overflow(acc, prod, &acc))
+        throw std::overflow_error("Arithmetic overflow");
+}
+
+/**
+    \brief Function for adding a multiple of one buffer to another with overflow checks on the accumulator
+    \param c pointer to the accumulator buffer, receives the sums
+    \param b pointer to the buffer to add, with values in the int range
+    \param a factor in the int range
+    \param count number of values in the buffers
+    \return Boolean value telling whether any accumulation overflowed 64 bits
+    \tparam T scalar type of the buffer to add
+
+    The same branch free test as in checkedMultiplyKernel, so the loop stays vectorizable.
+*/
+template<typename T>
+bool checkedAxpyKernel(long long* c, const T* b, long long a, std::size_t count)
+{
+    using U = unsigned long long;
+
+    U overflow = 0;
+    for (std::size_t j = 0; j < count; j++)
+    {
+        const U x = static_cast<U>(c[j]);
+        const U y = static_cast<U>(a) * static_cast<U>(b[j]);
+        const U sum = x + y;
+        overflow |= (sum ^ x) & (sum ^ y);
+        c[j] = static_cast<long long>(sum);
+    }
+
+    return (overflow >> 63) != 0;
+}
+
+/**
+    \brief Function for narrowing 64-bit results into the int range
+    \param vals pointer to the buffer, narrowed in place
+    \param count number of values in the buffer
+    \param policy how to handle values outside the int range
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline void narrowKernel(long long* vals, std::size_t count, ArithmeticPolicy policy)
+{
+    if (policy == ArithmeticPolicy::Wrapping)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            vals[i] = static_cast<int>(static_cast<unsigned int>(vals[i]));
+    }
+
+    else if (policy == ArithmeticPolicy::Saturating)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            vals[i] = std::min(std::max(vals[i], static_cast<long long>(INT_MIN)), static_cast<long long>(INT_MAX));
+    }
+
+    else
+    {
+        // A min/max reduction first, so the common case is a single branch per buffer
+        long long lo = 0;
+        long long hi = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            lo = std::min(lo, vals[i]);
+            hi = std::max(hi, vals[i]);
+        }
+        if (lo < INT_MIN || hi > INT_MAX)
+            throw std::overflow_error("Arithmetic overflow");
+    }
+}
+
+/**
+    \brief Function for telling whether the product of two views can be accumulated in 64 bits
+    \param a reference to the left hand side view with values in the int range
+    \param b reference to the right hand side view with values in the int range
+    \return Boolean value telling whether a.cols() * max|a| * max|b| fits into a long long
+    \tparam S scalar type of the views
+
+    The bound covers every partial sum, so a product accumulated with
+    wrap-around in unsigned 64-bit buffers, by any kernel, is then exact.
+*/
+template<typename S>
+bool productFitsKernel(const MatrixView<S>& a, const MatrixView<S>& b)
+{
+    const auto magnitude = [](const MatrixView<S>& v)
+    {
+        unsigned long long m = 0;
+        for (unsigned int i = 0; i < v.rows(); i++)
+        {
+            for (unsigned int j = 0; j < v.cols(); j++)
+            {
+                const long long x = v(i, j);
+                m = std::max(m, static_cast<unsigned long long>(x < 0 ? -x : x));
+            }
+        }
+        return m;
+    };
+
+    unsigned long long bound = 0;
+    return !__builtin_mul_overflow(magnitude(a), magnitude(b), &bound)
+        && !__builtin_mul_overflow(bound, static_cast<unsigned long long>(a.cols()), &bound)
+        && bound <= static_cast<unsigned long long>(LLONG_MAX);
+}
+
+/**
+    \brief Function for narrowing 128-bit results into the int range
+    \param wide pointer to the buffer of two's complement 128-bit results
+    \param vals pointer to the buffer receiving the narrowed values
+    \param count number of values in the buffers
+    \param policy how to handle values outside the int range
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline void narrowWideKernel(const unsigned __int128* wide, long long* vals, std::size_t count, ArithmeticPolicy policy)
+{
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const __int128 x = static_cast<__int128>(wide[i]);
+        if (policy == ArithmeticPolicy::Wrapping)
+            vals[i] = static_cast<int>(static_cast<unsigned int>(wide[i]));
+        else if (x >= INT_MIN && x <= INT_MAX)
+            vals[i] = static_cast<long long>(x);
+        else if (policy == ArithmeticPolicy::Saturating)
+            vals[i] = x < 0 ? INT_MIN : INT_MAX;
+        else
+            throw std::overflow_error("Arithmetic overflow");
+    }
+}
+
+/**
+    \brief Number of values the scratch buffers of the product kernels keep inline, enough for 8 x 8 matrices
+*/
+const std::size_t kernelInlineValues = 64;
+
+/**
+    \brief Function for multiplying two views with wrap-around in an unsigned accumulator type
+    \param a reference to the rows x inner left hand side view
+    \param b reference to the inner x cols right hand side view
+    \param c pointer to the rows x cols row-major result buffer
+    \param strassenFrom size at and above which square products use the Strassen-Winograd kernel
+    \param cancelled optional flag checked before every row of tiles, nullptr for none
+    \tparam U unsigned accumulator type
+    \tparam S scalar type of the views
+    \exception std::runtime_error Operation cancelled
+*/
+template<typename U, typename S>
+void wrappingMultiplyKernel(const MatrixView<S>& a, const MatrixView<S>& b, U* c, unsigned int strassenFrom,
+    const std::atomic<bool>* cancelled = nullptr)
+{
+    const unsigned int n = a.rows();
+    if (n == a.cols() && n == b.cols() && n >= strassenFrom)
+    {
+        // The recursion adds and subtracts quadrants, so it needs the operands in the accumulator type
+        std::vector<U> ua(static_cast<std::size_t>(n) * n);
+        std::vector<U> ub(static_cast<std::size_t>(n) * n);
+        packViewKernel(a, ua.data());
+        packViewKernel(b, ub.data());
+        strassenKernel(ua.data(), ub.data(), c, n, 64, cancelled);
+    }
+    else
+        blockedMultiplyKernel(a, b, c, b.cols(), 64, cancelled);
+}
+
+/**
+    \brief Function for multiplying two views and narrowing the result into the int range
+    \param a reference to the rows x inner left hand side view with values in the int range
+    \param b reference to the inner x cols right hand side view with values in the int range
+    \param c pointer to the rows x cols row-major result buffer
+    \param policy how to handle results outside the int range
+    \param strassenFrom size at and above which square products use the Strassen-Winograd kernel
+    \param cancelled optional flag checked before every row of tiles, nullptr for none
+    \tparam S scalar type of the views
+    \exception std::overflow_error Arithmetic overflow
+    \exception std::runtime_error Operation cancelled
+*/
+template<typename S>
+void policyMultiplyKernel(const MatrixView<S>& a, const MatrixView<S>& b, long long* c, ArithmeticPolicy policy, unsigned int strassenFrom,
+    const std::atomic<bool>* cancelled = nullptr)
+{
+    const std::size_t count = static_cast<std::size_t>(a.rows()) * b.cols();
+
+    if (policy == ArithmeticPolicy::Checked)
+    {
+        if (checkedMultiplyKernel(a, b, c, cancelled))
+            throw std::overflow_error("Arithmetic overflow");
+    }
+
+    // Unsigned accumulators make the wrap-around well defined,
+    // the bound check makes sure no sum wraps unless only the low bits are kept
+    else if (policy == ArithmeticPolicy::Wrapping || productFitsKernel(a, b))
+    {
+        SmallVector<unsigned long long, kernelInlineValues> uc(count);
+        wrappingMultiplyKernel(a, b, uc.data(), strassenFrom, cancelled);
+        std::copy(uc.begin(), uc.end(), c);
+    }
+
+    else
+    {
+        // A dot product of ints always fits into 128 bits
+        SmallVector<unsigned __int128, kernelInlineValues> wc(count);
+        wrappingMultiplyKernel(a, b, wc.data(), strassenFrom, cancelled);
+        narrowWideKernel(wc.data(), c, count, policy);
+        return;
+    }
+    narrowKernel(c, count, policy);
+}
+
+/**
+    \brief Function for multiplying two n x n row-major buffers modulo m
+    \param a pointer to the left hand side buffer with values in [0, m)
+    \param b pointer to the right hand side buffer with values in [0, m)
+    \param c pointer to the result buffer, must not alias a or b
+    \param n size of the matrices
+    \param m modulus
+    \param cancelled optional flag checked before every row, nullptr for none
+    \tparam T scalar type of the buffers, wide enough to hold (m - 1)^2 + m
+    \exception std::runtime_error Operation cancelled
+*/
+template<typename T>
+void multiplyModKernel(const T* a, const T* b, T* c, unsigned int n, T m, const std::atomic<bool>* cancelled = nullptr)
+{
+    for (unsigned int i = 0; i < n * n; i++)
+        c[i] = 0;
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        cancellationKernel(cancelled);
+        for (unsigned int k = 0; k < n; k++)
+        {
+            const T aik = a[i * n + k];
+            for (unsigned int j = 0; j < n; j++)
+                c[i * n + j] = (c[i * n + j] + aik * b[k * n + j]) % m;
+        }
+    }
+}
+
+/**
+    \brief Function for raising an n x n row-major buffer to the power k by binary exponentiation
+    \param base buffer holding the matrix, overwritten during the computation
+    \param res buffer receiving the result
+    \param tmp scratch buffer
+    \param n size of the matrix
+    \param k exponent
+    \param m modulus, 0 for none
+    \param cancelled optional flag checked before every product and every row of it, nullptr for none
+    \tparam T scalar type of the buffers
+    \exception std::runtime_error Operation cancelled
+
+    All three buffers must hold n * n values. They are reused for every step,
+    so no allocation takes place during the exponentiation.
+*/
+template<typename T>
+void powerKernel(std::vector<T>& base, std::vector<T>& res, std::vector<T>& tmp, unsigned int n, unsigned long long k, T m,
+    const std::atomic<bool>* cancelled = nullptr)
+{
+    // Start from the identity
+    for (unsigned int i = 0; i < n * n; i++)
+        res[i] = 0;
+    for (unsigned int i = 0; i < n; i++)
+        res[i * n + i] = (m == 1) ? 0 : 1;
+
+    while (k > 0)
+    {
+        cancellationKernel(cancelled);
+
+        if (k & 1)
+        {
+            if (m) multiplyModKernel(res.data(), base.data(), tmp.data(), n, m, cancelled);
+            else multiplyKernel(res.data(), base.data(), tmp.data(), n, cancelled);
+            res.swap(tmp);
+        }
+        k >>= 1;
+        if (k > 0)
+        {
+            if (m) multiplyModKernel(base.data(), base.data(), tmp.data(), n, m, cancelled);
+            else multiplyKernel(base.data(), base.data(), tmp.data(), n, cancelled);
+            base.swap(tmp);
+        }
+    }
+}
+
+/**
+    \brief Function for raising an n x n row-major buffer to the power k with overflow checks
+    \param base buffer holding the matrix with values in the int range, overwritten during the computation
+    \param res buffer receiving the result
+    \param tmp scratch buffer
+    \param n size of the matrix
+    \param k exponent
+    \param cancelled optional flag checked before every product and every row of it, nullptr for none
+    \exception std::overflow_error Arithmetic overflow
+    \exception std::runtime_error Operation cancelled
+
+    Every product is accumulated with checkedMultiplyKernel and narrowed
+    into the int range before it takes part in the next product, so an
+    intermediate matrix outside the int range throws instead of wrapping.
+*/
+inline void checkedPowerKernel(std::vector<long long>& base, std::vector<long long>& res, std::vector<long long>& tmp, unsigned int n,
+    unsigned long long k, const std::atomic<bool>* cancelled = nullptr)
+{
+    // Start from the identity
+    for (unsigned int i = 0; i < n * n; i++)
+        res[i] = 0;
+    for (unsigned int i = 0; i < n; i++)
+        res[i * n + i] = 1;
+
+    auto product = [&tmp, n, cancelled](const std::vector<long long>& a, const std::vector<long long>& b)
+    {
+        if (checkedMultiplyKernel(a.data(), b.data(), tmp.data(), n, cancelled))
+            throw std::overflow_error("Arithmetic overflow");
+        narrowKernel(tmp.data(), tmp.size(), ArithmeticPolicy::Widening);
+    };
+
+    while (k > 0)
+    {
+        cancellationKernel(cancelled);
+
+        if (k & 1)
+        {
+            product(res, base);
+            res.swap(tmp);
+        }
+        k >>= 1;
+        if (k > 0)
+        {
+            product(base, base);
+            base.swap(tmp);
+        }
+    }
+}
+
+/**
+    \brief Edge length of the column tiles of the Bareiss elimination kernel
+*/
+const unsigned int bareissTile = 256;
+
+/**
+    \brief Function for one fraction-free elimination step (x * akk - aik * akj) / prev
+    \param x value being updated
+    \param akk pivot
+    \param aik value of the updated row in the pivot column
+    \param akj value of the pivot row in the updated column
+    \param prev previous pivot, divides the numerator exactly
+    \return long long value of the updated value
+    \exception std::overflow_error Arithmetic overflow
+*/
+inline long long bareissStep(long long x, long long akk, long long aik, long long akj, long long prev)
+{
+    // Most steps fit into 64 bits, and a 64-bit division is several times cheaper
+    long long p1, p2, d;
+    const bool wide = __builtin_mul_overflow(x, akk, &p1) || __builtin_mul_overflow(aik, akj, &p2) || __builtin_sub_overflow(p1, p2, &d);
+    if (!wide)
+        return d / prev;
+
+#if defined(__SIZEOF_INT128__)
+    // Values are kept above LLONG_MIN, so both products and their difference fit into 128 bits
+    const __int128 q = (static_cast<__int128>(x) * akk - static_cast<__int128>(aik) * akj) / prev;
+    if (q > LLONG_MAX || q < -LLONG_MAX)
+        throw std::overflow_error("Arithmetic overflow");
+    return static_cast<long long>(q);
+#else
+    throw std::overflow_error("Arithmetic overflow");
+#endif
+}
+
+/**
+    \brief Function for the determinant of an n x n row-major buffer by Bareiss fraction-free elimination
+    \param a pointer to the buffer, destroyed by the elimination
+    \param n size of the matrix
+    \return long long value of the determinant
+    \exception std::overflow_error Arithmetic overflow
+
+    Every intermediate value is a minor of the matrix, so the elimination
+    stays exact in 64 bits as long as the minors do. The trailing rows are
+    updated one column tile at a time, so the tile of the pivot row stays
+    in cache while all the rows below it are swept.
+*/
+inline long long bareissKernel(long long* a, unsigned int n)
+{
+    long long prev = 1;
+    bool negate = false;
+
+    for (unsigned int k = 0; k + 1 < n; k++)
+    {
+        // Find a nonzero pivot, a row swap flips the sign
+        unsigned int p = k;
+        while (p < n && a[p * n + k] == 0)
+            p++;
+        if (p == n)
+            return 0;
+        if (p != k)
+        {
+            std::swap_ranges(a + p * n + k, a + (p + 1) * n, a + k * n + k);
+            negate = !negate;
+        }
+
+        const long long akk = a[k * n + k];
+        const long long* pivotRow = a + k * n;
+        for (unsigned int j0 = k + 1; j0 < n; j0 += bareissTile)
+        {
+            const unsigned int j1 = std::min(j0 + bareissTile, n);
+            for (unsigned int i = k + 1; i < n; i++)
+            {
+                long long* row = a + i * n;
+                const long long aik = row[k];
+
+                // Rows with a zero in the pivot column only scale, zeros stay zeros
+                if (aik == 0)
+                {
+                    for (unsigned int j = j0; j < j1; j++)
+                        if (row[j] != 0)
+                            row[j] = bareissStep(row[j], akk, 0, 0, prev);
+                }
+                else
+                {
+                    for (unsigned int j = j0; j < j1; j++)
+                        row[j] = bareissStep(row[j], akk, aik, pivotRow[j], prev);
+                }
+            }
+        }
+        prev = akk;
+    }
+
+    if (n == 0)
+        return 1;
+    const long long det = a[n * n - 1];
+    return negate ? -det : det;
+}
+
+/**
+    \brief Function for computing the high 64 bits of a 64 x 64-bit product
+    \param a unsigned 64-bit factor
+    \param b unsigned 64-bit factor
+    \return high half of the 128-bit product
+*/
+inline unsigned long long mulHigh64(unsigned long long a, unsigned long long b)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<unsigned long long>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+    const unsigned long long aLo = a & 0xffffffffULL;
+    const unsigned long long aHi = a >> 32;
+    const unsigned long long bLo = b & 0xffffffffULL;
+    const unsigned long long bHi = b >> 32;
+    const unsigned long long lh = aLo * bHi;
+    const unsigned long long hl = aHi * bLo;
+    const unsigned long long mid = ((aLo * bLo) >> 32) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    return aHi * bHi + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+/**
+    \class BarrettReducer
+    \brief Class for reducing 64-bit values modulo a fixed modulus with Barrett's method
+*/
+class BarrettReducer
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param m modulus, 1 <= m <= 2^31
+    */
+    constexpr explicit BarrettReducer(unsigned int m) : m(m), mu(~0ULL / (m ? m : 1)) {}
+
+    /**
+        \brief Getter for the modulus
+        \return unsigned int value of the modulus
+    */
+    constexpr unsigned int modulus() const { return m; }
+
+    /**
+        \brief Method for reducing a value
+        \param x unsigned 64-bit value
+        \return x mod m
+    */
+    unsigned int reduce(unsigned long long x) const
+    {
+        // The quotient estimate is at most a few short, fix it up with subtractions
+        unsigned long long r = x - mulHigh64(x, mu) * m;
+        while (r >= m)
+            r -= m;
+        return static_cast<unsigned int>(r);
+    }
+
+private:
+    unsigned int m;
+
+    unsigned long long mu;
+};
+
+/**
+    \brief Function for the largest prime not above a bound
+    \param p bound, at least 2
+    \return unsigned int value of the prime
+*/
+inline unsigned int previousPrime(unsigned int p)
+{
+    auto isPrime = [](unsigned int q)
+    {
+        if (q < 2 || q % 2 == 0)
+            return q == 2;
+        for (unsigned int d = 3; d <= q / d; d += 2)
+            if (q % d == 0)
+                return false;
+        return true;
+    };
+
+    while (!isPrime(p))
+        p--;
+    return p;
+}
+
+/**
+    \brief Function for the rank of an n x n row-major buffer modulo a prime
+    \param a pointer to the buffer with values in [0, p), destroyed by the elimination
+    \param n size of the matrix
+    \param p prime below 2^31
+    \return unsigned int value of the rank modulo p
+*/
+inline unsigned int rankModKernel(unsigned long long* a, unsigned int n, unsigned int p)
+{
+    const BarrettReducer red{ p };
+    unsigned int rank = 0;
+    for (unsigned int c = 0; c < n && rank < n; c++)
+    {
+        unsigned int piv = rank;
+        while (piv < n && a[piv * n + c] == 0)
+            piv++;
+        if (piv == n)
+            continue;
+        if (piv != rank)
+            std::swap_ranges(a + piv * n + c, a + (piv + 1) * n, a + rank * n + c);
+
+        // Inverse of the pivot by Fermat's little theorem
+        unsigned long long inv = 1;
+        unsigned long long b = a[rank * n + c];
+        for (unsigned int e = p - 2; e > 0; e >>= 1)
+        {
+            if (e & 1)
+                inv = red.reduce(inv * b);
+            b = red.reduce(b * b);
+        }
+
+        // Clear the column below the pivot, the rows above are not needed for the rank.
+        // Every sum stays below p + p^2 < 2^62, so one reduction per value is enough.
+        const unsigned long long* pivotRow = a + rank * n;
+        for (unsigned int i = rank + 1; i < n; i++)
+        {
+            unsigned long long* row = a + i * n;
+            const unsigned long long f = red.reduce(row[c] * inv);
+            if (f == 0)
+                continue;
+            for (unsigned int j = c; j < n; j++)
+                row[j] = red.reduce(row[j] + (p - f) * pivotRow[j]);
+        }
+        rank++;
+    }
+
+    return rank;
+}
+
+/**
+    \brief Function for the characteristic polynomial of an n x n row-major buffer by Berkowitz's algorithm
+    \param a pointer to the buffer
+    \param n size of the matrix
+    \return vector of the n + 1 coefficients of det(xI - A), the coefficient of x^n first
+    \exception std::overflow_error Arithmetic overflow
+
+    The algorithm is division free. The polynomial of each leading principal
+    submatrix is the one of the previous submatrix multiplied by a Toeplitz
+    matrix built from the products R A^k C of the new row and column.
+*/
+inline std::vector<long long> berkowitzKernel(const long long* a, unsigned int n)
+{
+    auto mulAdd = [](long long acc, long long x, long long y)
+    {
+        long long prod;
+        if (__builtin_mul_overflow(x, y, &prod) || __builtin_add_overflow(acc, prod, &acc))
+            throw std::overflow_error("Arithmetic overflow");
+        return acc;
+    };
+
+    std::vector<long long> poly{ 1 };
+    if (n == 0)
+        return poly;
+    poly.push_back(-a[0]);
+
+    std::vector<long long> t, v, w, next;
+    for (unsigned int r = 1; r < n; r++)
+    {
+        // First column of the Toeplitz matrix: 1, -a_rr, -R C, -R A C, ..., -R A^(r-1) C
+        t.assign(r + 2, 0);
+        t[0] = 1;
+        t[1] = -a[r * n + r];
+        v.resize(r);
+        for (unsigned int i = 0; i < r; i++)
+            v[i] = a[i * n + r];
+        for (unsigned int k = 0; k < r; k++)
+        {
+            long long s = 0;
+            for (unsigned int i = 0; i < r; i++)
+                s = mulAdd(s, -a[r * n + i], v[i]);
+            t[k + 2] = s;
+
+            if (k + 1 < r)
+            {
+                w.assign(r, 0);
+                for (unsigned int i = 0; i < r; i++)
+                    for (unsigned int j = 0; j < r; j++)
+                        w[i] = mulAdd(w[i], a[i * n + j], v[j]);
+                v.swap(w);
+            }
+        }
+
+        next.assign(r + 2, 0);
+        for (unsigned int i = 0; i < r + 2; i++)
+            for (unsigned int j = 0; j <= std::min(i, r); j++)
+                next[i] = mulAdd(next[i], t[i - j], poly[j]);
+        poly.swap(next);
+    }
+
+    return poly;
+}
+
+/**
+    \brief Number of output values below which the assembly kernels stay on the calling thread
+*/
+const std::size_t parallelThreshold = 1 << 16;
+
+/**
+    \brief Function for running f over [0, count) split into contiguous ranges, one per hardware thread
+    \param count number of items, such as output rows
+    \param work number of output values, small outputs run on the calling thread
+    \param f callable taking the first and one past the last item of a range
+    \tparam F type of the callable
+
+    Every range must write to its own part of the output. An exception thrown
+    by any range is rethrown on the calling thread.
+*/
+template<typename F>
+void parallelRangeKernel(unsigned int count, std::size_t work, const F& f)
+{
+    unsigned int workers = std::thread::hardware_concurrency();
+    if (work < parallelThreshold || workers < 2 || count < 2)
+    {
+        f(0u, count);
+        return;
+    }
+
+    workers = std::min(workers, count);
+    const unsigned int chunk = (count + workers - 1) / workers;
+    std::vector<std::future<void>> parts;
+    for (unsigned int lo = chunk; lo < count; lo += chunk)
+    {
+        const unsigned int hi = std::min(lo + chunk, count);
+        parts.push_back(std::async(std::launch::async, [&f, lo, hi]() { f(lo, hi); }));
+    }
+    f(0u, std::min(chunk, count));
+    for (auto& part : parts)
+        part.get();
+}
@@ -0,0 +1,179 @@
+/**
+    \file matrixview.h
+    \brief Header for the MatrixView class template and the kernels working on views
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+/**
+    \class MatrixView
+    \brief Defines a non-owning strided view into row-major matrix storage
+    \tparam T scalar type of the viewed storage
+
+    A view is a pointer and two strides, so transposing, taking blocks,
+    slices or the diagonal never copies values. The viewed matrix must
+    outlive the view and must not be resized while the view is in use.
+*/
+template<typename T> class MatrixView
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param data pointer to the first viewed value
+        \param rows number of rows
+        \param cols number of columns
+        \param rowStride distance between two rows in values
+        \param colStride distance between two columns in values
+    */
+    MatrixView(const T* data, unsigned int rows, unsigned int cols, std::ptrdiff_t rowStride, std::ptrdiff_t colStride)
+        : ptr(data), nRows(rows), nCols(cols), rStride(rowStride), cStride(colStride) {}
+
+    /**
+        \brief Getter for the number of rows
+        \return unsigned int value of the number of rows
+    */
+    unsigned int rows() const { return nRows; }
+
+    /**
+        \brief Getter for the number of columns
+        \return unsigned int value of the number of columns
+    */
+    unsigned int cols() const { return nCols; }
+
+    /**
+        \brief Getter for the pointer to the first viewed value
+        \return pointer to the value at row 0 and column 0
+    */
+    const T* data() const { return ptr; }
+
+    /**
+        \brief Getter for the distance between two rows
+        \return ptrdiff_t value of the row stride in values
+    */
+    std::ptrdiff_t rowStride() const { return rStride; }
+
+    /**
+        \brief Getter for the distance between two columns
+        \return ptrdiff_t value of the column stride in values
+    */
+    std::ptrdiff_t colStride() const { return cStride; }
+
+    /**
+        \brief Operator for reading a value
+        \param i row index
+        \param j column index
+        \return T value at row i and column j
+    */
+    T operator ()(unsigned int i, unsigned int j) const { return ptr[i * rStride + j * cStride]; }
+
+    /**
+        \brief Method for checking if the rows are contiguous and follow each other without gaps
+        \return Boolean value of the check
+    */
+    bool isContiguous() const { return cStride == 1 && rStride == static_cast<std::ptrdiff_t>(nCols); }
+
+    /**
+        \brief Method for creating a transposed view
+        \return MatrixView object with rows and columns swapped
+    */
+    MatrixView<T> transposed() const { return MatrixView<T>(ptr, nCols, nRows, cStride, rStride); }
+
+    /**
+        \brief Method for creating a view of a block
+        \param r0 first row of the block
+        \param c0 first column of the block
+        \param rows number of rows in the block
+        \param cols number of columns in the block
+        \return MatrixView object of the block
+        \exception std::out_of_range Block outside the view
+    */
+    MatrixView<T> block(unsigned int r0, unsigned int c0, unsigned int rows, unsigned int cols) const
+    {
+        if (r0 + rows > nRows || c0 + cols > nCols)
+            throw std::out_of_range("Block outside the view");
+        return MatrixView<T>(ptr + r0 * rStride + c0 * cStride, rows, cols, rStride, cStride);
+    }
+
+    /**
+        \brief Method for creating a view of a row
+        \param i row index
+        \return MatrixView object with one row
+        \exception std::out_of_range Block outside the view
+    */
+    MatrixView<T> row(unsigned int i) const { return block(i, 0, 1, nCols); }
+
+    /**
+        \brief Method for creating a view of a column
+        \param j column index
+        \return MatrixView object with one column
+        \exception std::out_of_range Block outside the view
+    */
+    MatrixView<T> column(unsigned int j) const { return block(0, j, nRows, 1); }
+
+    /**
+        \brief Method for creating a view of the main diagonal
+        \return MatrixView object with one row holding the diagonal values
+    */
+    MatrixView<T> diagonal() const
+    {
+        const unsigned int len = nRows < nCols ? nRows : nCols;
+        return MatrixView<T>(ptr, len ? 1 : 0, len, 0, rStride + cStride);
+    }
+
+private:
+    const T* ptr;
+
+    unsigned int nRows;
+
+    unsigned int nCols;
+
+    std::ptrdiff_t rStride;
+
+    std::ptrdiff_t cStride;
+};
+
+/**
+    \brief Function for copying a view into a row-major buffer
+    \param v reference to the view
+    \param dst pointer to the v.rows() x v.cols() destination buffer
+    \tparam Acc scalar type of the destination buffer
+    \tparam T scalar type of the view
+
+    Transposed and strided views are gathered once, so the packed copy can
+    go through the same contiguous kernels as an owning matrix.
+*/
+template<typename Acc, typename T>
+void packViewKernel(const MatrixView<T>& v, Acc* dst)
+{
+    for (unsigned int i = 0; i < v.rows(); i++)
+    {
+        Acc* row = dst + static_cast<std::size_t>(i) * v.cols();
+        for (unsigned int j = 0; j < v.cols(); j++)
+            row[j] = static_cast<Acc>(v(i, j));
+    }
+}
+
+/**
+    \brief Function for combining two views of the same shape element by element into a row-major buffer
+    \param a reference to the left hand side view
+    \param b reference to the right hand side view
+    \param c pointer to the a.rows() x a.cols() result buffer
+    \param sign +1 for addition, -1 for subtraction
+    \tparam Acc accumulator type of the result buffer
+    \tparam T scalar type of the views
+*/
+template<typename Acc, typename T>
+void addViewKernel(const MatrixView<T>& a, const MatrixView<T>& b, Acc* c, int sign)
+{
+    for (unsigned int i = 0; i < a.rows(); i++)
+    {
+        for (unsigned int j = 0; j < a.cols(); j++)
+        {
+            const Acc rhs = static_cast<Acc>(b(i, j));
+            c[i * a.cols() + j] = static_cast<Acc>(a(i, j)) + (sign > 0 ? rhs : -rhs);
+        }
+    }
+}
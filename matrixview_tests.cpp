@@ -0,0 +1,75 @@
+/**
+    \file matrixview_tests.cpp
+    \brief Unit tests for the MatrixView class template and the operators on views
+*/
+
+#include "catch.hpp"
+#include "elementarymatrix.h"
+
+TEST_CASE("MatrixView slicing test", "[MatrixView]")
+{
+    ConcreteSquareMatrix m{ "[[1,2,3][4,5,6][7,8,9]]" };
+    MatrixView<int> v = m.view();
+    CHECK(v.rows() == 3);
+    CHECK(v.isContiguous());
+    CHECK(v(1, 2) == 6);
+    CHECK(m.transposedView()(1, 2) == 8);
+    CHECK_FALSE(m.transposedView().isContiguous());
+
+    MatrixView<int> b = v.block(1, 1, 2, 2);
+    CHECK(b(0, 0) == 5);
+    CHECK(b(1, 1) == 9);
+    CHECK(b.transposed()(0, 1) == 8);
+    CHECK_THROWS_AS(v.block(2, 2, 2, 1), std::out_of_range);
+
+    MatrixView<int> d = v.diagonal();
+    CHECK(d.rows() == 1);
+    CHECK(d.cols() == 3);
+    CHECK(d(0, 0) == 1);
+    CHECK(d(0, 2) == 9);
+    CHECK(v.transposed().diagonal()(0, 1) == 5);
+
+    CHECK(v.row(2)(0, 1) == 8);
+    CHECK(v.column(2)(1, 0) == 6);
+    CHECK(v.column(2).transposed()(0, 2) == 9);
+
+    SymbolicSquareMatrix s{ "[[x]]" };
+    CHECK_THROWS_WITH(s.view(), "Incompatible matrices");
+}
+
+TEST_CASE("MatrixView arithmetic operator test", "[MatrixView]")
+{
+    ConcreteSquareMatrix m1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ConcreteSquareMatrix m2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    CHECK(m1.view() + m2.view() == m1 + m2);
+    CHECK(m1.view() - m2.view() == m1 - m2);
+    CHECK(m1.view() * m2.view() == m1 * m2);
+
+    // Transposed operands are gathered by their strides
+    CHECK(m1.transposedView() * m2.view() == m1.transpose() * m2);
+    CHECK(m1.view() * m2.transposedView() == m1 * m2.transpose());
+    CHECK(m1.transposedView() + m2.view() == m1.transpose() + m2);
+
+    // Blocks and slices: column times row is an outer product
+    CHECK((m1.view().block(0, 0, 2, 2) * m2.view().block(1, 1, 2, 2)).toString() == "[[13,9][0,-21]]");
+    CHECK((m1.view().column(0) * m2.view().row(0)).toString() == "[[-15,0,-6][35,0,14][-30,0,-12]]");
+    CHECK((m1.view().row(0) * m2.view().column(0)).toString() == "[[-16]]");
+
+    // Larger than one tile of the blocked kernel
+    std::vector<long long> vals(100 * 100);
+    for (std::size_t i = 0; i < vals.size(); i++)
+        vals[i] = static_cast<long long>(i % 17) - 8;
+    ConcreteSquareMatrix big = ConcreteSquareMatrix::fromValues(100, vals);
+    CHECK(big.transposedView() * big.view() == big.transpose() * big);
+    CHECK(big.view() * big.transposedView() == big * big.transpose());
+    CHECK(big.transposedView() * big.transposedView() == big.transpose() * big.transpose());
+    CHECK(big.transposedView().block(10, 20, 70, 70) * big.view().block(5, 5, 70, 70)
+        == big.transpose().view().block(10, 20, 70, 70) * big.view().block(5, 5, 70, 70));
+
+    // 4 * 2^62 wraps to exactly 0 in 64 bits
+    ConcreteSquareMatrix min4 = ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, INT_MIN));
+    CHECK_THROWS_WITH(min4.view() * min4.transposedView(), "Arithmetic overflow");
+
+    CHECK_THROWS_WITH(m1.view() * m2.view().block(0, 0, 2, 2), "Incompatible matrices");
+    CHECK_THROWS_WITH(m1.view().row(0) + m2.view().row(0), "Incompatible matrices");
+}
@@ -0,0 +1,430 @@
+/**
+    \file modularmatrix.h
+    \brief Header for the ModularSquareMatrix class template and the modulus classes
+*/
+
+#pragma once
+
+#include "elementarymatrix.h"
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+/**
+    \class StaticModulus
+    \brief Class for a modulus fixed at compile time
+    \tparam P modulus, 1 <= P <= 2^31
+*/
+template<unsigned int P> class StaticModulus
+{
+    static_assert(P > 0 && P <= (1u << 31), "Invalid modulus");
+
+public:
+    /**
+        \brief Getter for the modulus
+        \return unsigned int value of the modulus
+    */
+    static constexpr unsigned int modulus() { return P; }
+
+    /**
+        \brief Method for reducing a value
+        \param x unsigned 64-bit value
+        \return x mod P
+    */
+    static unsigned int reduce(unsigned long long x)
+    {
+        constexpr BarrettReducer reducer{ P };
+        return reducer.reduce(x);
+    }
+};
+
+/**
+    \class DynamicModulus
+    \brief Class for a modulus chosen at runtime
+*/
+class DynamicModulus
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param m modulus, 1 <= m <= 2^31
+        \exception std::invalid_argument Invalid modulus
+    */
+    explicit DynamicModulus(unsigned int m) : reducer(m)
+    {
+        if (m == 0 || m > (1u << 31))
+            throw std::invalid_argument("Invalid modulus");
+    }
+
+    /**
+        \brief Getter for the modulus
+        \return unsigned int value of the modulus
+    */
+    unsigned int modulus() const { return reducer.modulus(); }
+
+    /**
+        \brief Method for reducing a value
+        \param x unsigned 64-bit value
+        \return x mod m
+    */
+    unsigned int reduce(unsigned long long x) const { return reducer.reduce(x); }
+
+private:
+    BarrettReducer reducer;
+};
+
+/**
+    \class ModularSquareMatrix
+    \brief Defines a class for a matrix of residues modulo an integer
+    \tparam Modulus StaticModulus or DynamicModulus
+*/
+template<typename Modulus> class ModularSquareMatrix
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param str_m String representation of the matrix, values are reduced into [0, modulus)
+        \param mod modulus
+        \tparam Modulus type of the modulus
+        \exception std::invalid_argument Not a square matrix
+    */
+    ModularSquareMatrix<Modulus>(const std::string& str_m, Modulus mod = Modulus());
+
+    /**
+        \brief Parametric constructor
+        \param m reference to a ConcreteSquareMatrix object whose values are reduced into [0, modulus)
+        \param mod modulus
+        \tparam Modulus type of the modulus
+    */
+    ModularSquareMatrix<Modulus>(const ConcreteSquareMatrix& m, Modulus mod = Modulus());
+
+    /**
+        \brief Method for creating a string representation of the matrix
+        \return string that is the string representation of the matrix
+    */
+    std::string toString() const;
+
+    /**
+        \brief Method for converting the residues into a ConcreteSquareMatrix
+        \return ConcreteSquareMatrix object holding the residues
+    */
+    ConcreteSquareMatrix toConcrete() const;
+
+    /**
+        \brief Getter for the size n of the matrix
+        \return unsigned int value of the attribute n
+    */
+    unsigned int getN() const;
+
+    /**
+        \brief Getter for the modulus
+        \return unsigned int value of the modulus
+    */
+    unsigned int getModulus() const;
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a ModularSquareMatrix object to compare to
+        \tparam Modulus type of the modulus
+        \return Boolean value of the comparison
+    */
+    bool operator ==(const ModularSquareMatrix<Modulus>& rhs) const;
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a ModularSquareMatrix object that is the matrix to add
+        \tparam Modulus type of the modulus
+        \return Reference to a ModularSquareMatrix object that is the result of the addition
+        \exception std::invalid_argument Incompatible matrices
+    */
+    ModularSquareMatrix<Modulus>& operator +=(const ModularSquareMatrix<Modulus>& rhs);
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a ModularSquareMatrix object that is the matrix to subtract
+        \tparam Modulus type of the modulus
+        \return Reference to a ModularSquareMatrix object that is the result of the subtraction
+        \exception std::invalid_argument Incompatible matrices
+    */
+    ModularSquareMatrix<Modulus>& operator -=(const ModularSquareMatrix<Modulus>& rhs);
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a ModularSquareMatrix object that is the matrix to multiply with
+        \tparam Modulus type of the modulus
+        \return Reference to a ModularSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+    */
+    ModularSquareMatrix<Modulus>& operator *=(const ModularSquareMatrix<Modulus>& rhs);
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a ModularSquareMatrix object that is the right hand side of the addition
+        \tparam Modulus type of the modulus
+        \return ModularSquareMatrix object that is the result of the addition
+        \exception std::invalid_argument Incompatible matrices
+    */
+    ModularSquareMatrix<Modulus> operator +(const ModularSquareMatrix<Modulus>& rhs) const;
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a ModularSquareMatrix object that is the right hand side of the subtraction
+        \tparam Modulus type of the modulus
+        \return ModularSquareMatrix object that is the result of the subtraction
+        \exception std::invalid_argument Incompatible matrices
+    */
+    ModularSquareMatrix<Modulus> operator -(const ModularSquareMatrix<Modulus>& rhs) const;
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a ModularSquareMatrix object that is the right hand side of the multiplication
+        \tparam Modulus type of the modulus
+        \return ModularSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+    */
+    ModularSquareMatrix<Modulus> operator *(const ModularSquareMatrix<Modulus>& rhs) const;
+
+    /**
+        \brief Method for raising the matrix to a non-negative integer power by binary exponentiation
+        \param k exponent, k = 0 gives the identity matrix
+        \tparam Modulus type of the modulus
+        \return ModularSquareMatrix object that is the matrix to the power k
+    */
+    ModularSquareMatrix<Modulus> power(unsigned long long k) const;
+
+private:
+    Modulus mod;
+
+    unsigned int n;
+
+    std::vector<unsigned int> vals;
+
+    /**
+        \brief Method for checking that a matrix has the same size and modulus
+        \param rhs reference to a ModularSquareMatrix object
+        \exception std::invalid_argument Incompatible matrices
+    */
+    void checkCompatible(const ModularSquareMatrix<Modulus>& rhs) const;
+
+    /**
+        \brief Method for multiplying two row-major residue buffers with delayed reduction
+        \param a left hand side buffer
+        \param b right hand side buffer
+        \param c result buffer, must not alias a or b
+        \param acc scratch buffer of n accumulators
+    */
+    void multiplyInto(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b,
+        std::vector<unsigned int>& c, std::vector<unsigned long long>& acc) const;
+};
+
+/**
+    \class ModPSquareMatrix
+    \brief Class for a matrix of residues modulo the prime 10^9 + 7
+*/
+using ModPSquareMatrix = ModularSquareMatrix<StaticModulus<1000000007u>>;
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus>::ModularSquareMatrix(const std::string& str_m, Modulus mod)
+    : ModularSquareMatrix<Modulus>(ConcreteSquareMatrix{ str_m }, mod)
+{
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus>::ModularSquareMatrix(const ConcreteSquareMatrix& m, Modulus mod) : mod(mod), n(m.getN())
+{
+    const long long p = mod.modulus();
+    for (long long x : m.values())
+        vals.push_back(static_cast<unsigned int>(((x % p) + p) % p));
+}
+
+template<typename Modulus>
+std::string ModularSquareMatrix<Modulus>::toString() const
+{
+    // Initialize the string
+    std::string str = "[";
+
+    // Empty matrix case
+    if (n == 0)
+        str.append("[]]");
+
+    else
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            // Add each residue of the row and separate them with ','
+            str.push_back('[');
+            for (unsigned int j = 0; j < n; j++)
+            {
+                str.append(std::to_string(vals[i * n + j]));
+                str.push_back(',');
+            }
+
+            // Remove last ',' and close the row
+            str.pop_back();
+            str.push_back(']');
+        }
+        // Close the matrix
+        str.push_back(']');
+    }
+
+    return str;
+}
+
+template<typename Modulus>
+ConcreteSquareMatrix ModularSquareMatrix<Modulus>::toConcrete() const
+{
+    // Residues up to 2^31 - 1 fit into an int, only the modulus 2^31 itself may not
+    std::vector<long long> res(vals.begin(), vals.end());
+    narrowKernel(res.data(), res.size(), ArithmeticPolicy::Widening);
+    return ConcreteSquareMatrix::fromValues(n, res);
+}
+
+template<typename Modulus>
+unsigned int ModularSquareMatrix<Modulus>::getN() const { return n; }
+
+template<typename Modulus>
+unsigned int ModularSquareMatrix<Modulus>::getModulus() const { return mod.modulus(); }
+
+template<typename Modulus>
+bool ModularSquareMatrix<Modulus>::operator ==(const ModularSquareMatrix<Modulus>& rhs) const
+{
+    return n == rhs.n && getModulus() == rhs.getModulus() && vals == rhs.vals;
+}
+
+template<typename Modulus>
+void ModularSquareMatrix<Modulus>::checkCompatible(const ModularSquareMatrix<Modulus>& rhs) const
+{
+    if (n != rhs.n || getModulus() != rhs.getModulus())
+        throw std::invalid_argument("Incompatible matrices");
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus>& ModularSquareMatrix<Modulus>::operator +=(const ModularSquareMatrix<Modulus>& rhs)
+{
+    checkCompatible(rhs);
+
+    // Both residues are below m <= 2^31, so their sum fits into 32 bits
+    const unsigned int m = getModulus();
+    for (std::size_t i = 0; i < vals.size(); i++)
+    {
+        const unsigned int sum = vals[i] + rhs.vals[i];
+        vals[i] = (sum >= m) ? sum - m : sum;
+    }
+
+    return *this;
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus>& ModularSquareMatrix<Modulus>::operator -=(const ModularSquareMatrix<Modulus>& rhs)
+{
+    checkCompatible(rhs);
+
+    const unsigned int m = getModulus();
+    for (std::size_t i = 0; i < vals.size(); i++)
+        vals[i] = (vals[i] >= rhs.vals[i]) ? vals[i] - rhs.vals[i] : vals[i] + (m - rhs.vals[i]);
+
+    return *this;
+}
+
+template<typename Modulus>
+void ModularSquareMatrix<Modulus>::multiplyInto(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b,
+    std::vector<unsigned int>& c, std::vector<unsigned long long>& acc) const
+{
+    const unsigned long long m = getModulus();
+    const unsigned long long sq = (m - 1) * (m - 1);
+
+    // Number of products that fit into a 64-bit accumulator on top of a reduced value.
+    // For m <= 2^31 this is at least 3, for m < 2^30 at least 15.
+    const unsigned long long lazy = sq ? (~0ULL - m) / sq : n + 1;
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        std::fill(acc.begin(), acc.end(), 0);
+        unsigned long long pending = 0;
+        for (unsigned int k = 0; k < n; k++)
+        {
+            const unsigned long long aik = a[i * n + k];
+            for (unsigned int j = 0; j < n; j++)
+                acc[j] += aik * b[k * n + j];
+
+            // Reduce only when the next row of products could overflow
+            if (++pending == lazy)
+            {
+                for (unsigned int j = 0; j < n; j++)
+                    acc[j] = mod.reduce(acc[j]);
+                pending = 0;
+            }
+        }
+        for (unsigned int j = 0; j < n; j++)
+            c[i * n + j] = mod.reduce(acc[j]);
+    }
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus>& ModularSquareMatrix<Modulus>::operator *=(const ModularSquareMatrix<Modulus>& rhs)
+{
+    checkCompatible(rhs);
+
+    std::vector<unsigned int> res(vals.size());
+    std::vector<unsigned long long> acc(n);
+    multiplyInto(vals, rhs.vals, res, acc);
+    vals.swap(res);
+
+    return *this;
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus> ModularSquareMatrix<Modulus>::operator +(const ModularSquareMatrix<Modulus>& rhs) const
+{
+    ModularSquareMatrix<Modulus> res{ *this };
+    res += rhs;
+    return res;
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus> ModularSquareMatrix<Modulus>::operator -(const ModularSquareMatrix<Modulus>& rhs) const
+{
+    ModularSquareMatrix<Modulus> res{ *this };
+    res -= rhs;
+    return res;
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus> ModularSquareMatrix<Modulus>::operator *(const ModularSquareMatrix<Modulus>& rhs) const
+{
+    ModularSquareMatrix<Modulus> res{ *this };
+    res *= rhs;
+    return res;
+}
+
+template<typename Modulus>
+ModularSquareMatrix<Modulus> ModularSquareMatrix<Modulus>::power(unsigned long long k) const
+{
+    // Buffers are allocated once and reused for every step
+    ModularSquareMatrix<Modulus> res{ *this };
+    std::vector<unsigned int> base = vals;
+    std::vector<unsigned int> tmp(vals.size());
+    std::vector<unsigned long long> acc(n);
+
+    // Start from the identity
+    std::fill(res.vals.begin(), res.vals.end(), 0);
+    for (unsigned int i = 0; i < n; i++)
+        res.vals[i * n + i] = mod.reduce(1);
+
+    while (k > 0)
+    {
+        if (k & 1)
+        {
+            multiplyInto(res.vals, base, tmp, acc);
+            res.vals.swap(tmp);
+        }
+        k >>= 1;
+        if (k > 0)
+        {
+            multiplyInto(base, base, tmp, acc);
+            base.swap(tmp);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,97 @@
+/**
+    \file modularmatrix_tests.cpp
+    \brief Unit tests for the ModularSquareMatrix class template and the modulus classes
+*/
+
+#include "catch.hpp"
+#include "modularmatrix.h"
+
+TEST_CASE("BarrettReducer reduce method test", "[BarrettReducer]")
+{
+    for (unsigned int m : { 1u, 2u, 3u, 7u, 1024u, 65521u, 1000000007u, 2147483647u, 2147483648u })
+    {
+        BarrettReducer r{ m };
+        for (unsigned long long x : { 0ULL, 1ULL, 6ULL, 1000000006ULL, 4611686014132420609ULL, 18446744073709551615ULL })
+            CHECK(r.reduce(x) == x % m);
+    }
+}
+
+TEST_CASE("ModularSquareMatrix parametric constructor test", "[ModularSquareMatrix]")
+{
+    ModularSquareMatrix<StaticModulus<7>> m1{ "[[3,-1][15,-14]]" };
+    CHECK(m1.toString() == "[[3,6][1,0]]");
+    CHECK(m1.getModulus() == 7);
+    ModularSquareMatrix<DynamicModulus> m2{ ConcreteSquareMatrix{ "[[3,-1][15,-14]]" }, DynamicModulus{ 5 } };
+    CHECK(m2.toString() == "[[3,4][0,1]]");
+    CHECK(m2.toConcrete().toString() == "[[3,4][0,1]]");
+    ModularSquareMatrix<DynamicModulus> m3{ "[[]]", DynamicModulus{ 5 } };
+    CHECK(m3.toString() == "[[]]");
+    CHECK_THROWS_WITH((ModularSquareMatrix<DynamicModulus>{ "[[1]]", DynamicModulus{ 0 } }), "Invalid modulus");
+    CHECK_THROWS_WITH((ModularSquareMatrix<StaticModulus<7>>{ "" }), "Not a square matrix");
+}
+
+TEST_CASE("ModularSquareMatrix arithmetic operator test", "[ModularSquareMatrix]")
+{
+    ModularSquareMatrix<StaticModulus<11>> m1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ModularSquareMatrix<StaticModulus<11>> m2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    ConcreteSquareMatrix c1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ConcreteSquareMatrix c2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    CHECK((m1 + m2) == ModularSquareMatrix<StaticModulus<11>>{ c1 + c2 });
+    CHECK((m1 - m2) == ModularSquareMatrix<StaticModulus<11>>{ c1 - c2 });
+    CHECK((m1 * m2) == ModularSquareMatrix<StaticModulus<11>>{ c1 * c2 });
+    CHECK((m1 *= m2).toString() == "[[6,3,2][0,3,8][3,4,10]]");
+
+    ModularSquareMatrix<DynamicModulus> d1{ c1, DynamicModulus{ 11 } };
+    ModularSquareMatrix<DynamicModulus> d2{ c2, DynamicModulus{ 13 } };
+    CHECK_THROWS_WITH(d1 + d2, "Incompatible matrices");
+    ModularSquareMatrix<DynamicModulus> d3{ "[[1]]", DynamicModulus{ 11 } };
+    CHECK_THROWS_AS(d1 * d3, std::invalid_argument);
+}
+
+TEST_CASE("ModularSquareMatrix delayed reduction test", "[ModularSquareMatrix]")
+{
+    // Residues close to 2^31 allow only three products per reduction
+    const long long p = 2147483647;
+    std::string str = "[";
+    for (unsigned int i = 0; i < 9; i++)
+    {
+        str.push_back('[');
+        for (unsigned int j = 0; j < 9; j++)
+            str.append(std::to_string(p - 1 - static_cast<long long>(i * 9 + j)) + ",");
+        str.back() = ']';
+    }
+    str.push_back(']');
+    ModularSquareMatrix<StaticModulus<2147483647u>> m{ ConcreteSquareMatrix{ str } };
+    ModularSquareMatrix<StaticModulus<2147483647u>> sq = m * m;
+
+    // Reference with a reduction after every product, (p - 1 - a)(p - 1 - b) = (1 + a)(1 + b) mod p
+    std::string expected = "[";
+    for (unsigned int i = 0; i < 9; i++)
+    {
+        expected.push_back('[');
+        for (unsigned int j = 0; j < 9; j++)
+        {
+            long long acc = 0;
+            for (unsigned int k = 0; k < 9; k++)
+                acc = (acc + (1 + i * 9 + k) * (1 + k * 9 + j)) % p;
+            expected.append(std::to_string(acc) + ",");
+        }
+        expected.back() = ']';
+    }
+    expected.push_back(']');
+    CHECK(sq.toString() == expected);
+}
+
+TEST_CASE("ModularSquareMatrix power method test", "[ModularSquareMatrix]")
+{
+    ModPSquareMatrix fib{ "[[1,1][1,0]]" };
+    CHECK(fib.power(0).toString() == "[[1,0][0,1]]");
+    CHECK(fib.power(10).toString() == "[[89,55][55,34]]");
+    // F(1000) mod 10^9 + 7
+    CHECK(fib.power(999).toString().substr(0, 11) == "[[517691607");
+    ConcreteSquareMatrix c{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    ModularSquareMatrix<DynamicModulus> m{ c, DynamicModulus{ 5 } };
+    CHECK(m.power(3).toConcrete() == c.power(3, 5));
+    ModularSquareMatrix<DynamicModulus> one{ c, DynamicModulus{ 1 } };
+    CHECK(one.power(0).toString() == "[[0,0,0][0,0,0][0,0,0]]");
+}
@@ -0,0 +1,451 @@
+/**
+    \file numericmatrix.h
+    \brief Header for the NumericSquareMatrix class template
+*/
+
+#pragma once
+
+#include "elementarymatrix.h"
+#include "matrixkernels.h"
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+
+/**
+    \brief Function for parsing the string representation of a square matrix of numbers
+    \param str reference to a string such as "[[1.5,2][3,-4e2]]"
+    \param n receives the size of the matrix
+    \param vals receives the values in row-major order
+    \tparam T scalar type of the values
+    \return Boolean value telling whether the string represents a square matrix
+*/
+template<typename T>
+bool parseNumericSquareMatrix(const std::string& str, unsigned int& n, std::vector<T>& vals)
+{
+    n = 0;
+    vals.clear();
+
+    // Special cases for the empty matrix
+    if (str == "[]" || str == "[[]]")
+        return true;
+
+    if (str.length() < 4 || str.front() != '[' || str.back() != ']')
+        return false;
+
+    const char* p = str.data() + 1;
+    const char* end = str.data() + str.length() - 1;
+    unsigned int rows = 0;
+    while (p < end)
+    {
+        // Each row begins with '['
+        if (*p != '[')
+            return false;
+        p++;
+
+        // Read the values of the row until ']'
+        unsigned int cols = 0;
+        while (true)
+        {
+            T v;
+            auto res = std::from_chars(p, end, v);
+            if (res.ec != std::errc())
+                return false;
+            vals.push_back(v);
+            cols++;
+            p = res.ptr;
+
+            if (p < end && *p == ',')
+                p++;
+            else if (p < end && *p == ']')
+            {
+                p++;
+                break;
+            }
+            else
+                return false;
+        }
+
+        // Every row must have the same dimension
+        if (rows == 0)
+            n = cols;
+        else if (cols != n)
+            return false;
+        rows++;
+    }
+
+    // Check that rows equal columns
+    return rows == n;
+}
+
+/**
+    \class NumericSquareMatrix
+    \brief Defines a class for a matrix of numbers stored contiguously in row-major order
+    \tparam T scalar type, such as int, long long, float or double
+
+    Every instantiation compiles its own copy of the buffer kernels, so the
+    compiler vectorizes them for the width of T. Integer instantiations keep
+    the overflow behaviour of T, use ConcreteSquareMatrix with an
+    ArithmeticPolicy when overflow has to be handled.
+*/
+template<typename T> class NumericSquareMatrix
+{
+    static_assert(std::is_arithmetic<T>::value, "NumericSquareMatrix requires an arithmetic type");
+
+public:
+    /**
+        \brief Default constructor
+        \tparam T scalar type of the matrix
+    */
+    NumericSquareMatrix<T>();
+
+    /**
+        \brief Parametric constructor
+        \param str_m String representation of the matrix
+        \tparam T scalar type of the matrix
+        \exception std::invalid_argument Not a square matrix
+    */
+    NumericSquareMatrix<T>(const std::string& str_m);
+
+    /**
+        \brief Parametric constructor
+        \param size size n of the matrix
+        \param v vector of the size * size values in row-major order
+        \tparam T scalar type of the matrix
+        \exception std::invalid_argument Not a square matrix
+    */
+    NumericSquareMatrix<T>(unsigned int size, std::vector<T> v);
+
+    /**
+        \brief Parametric constructor
+        \param m reference to a ConcreteSquareMatrix object whose values are converted to T
+        \tparam T scalar type of the matrix
+    */
+    explicit NumericSquareMatrix<T>(const ConcreteSquareMatrix& m);
+
+    /**
+        \brief Method for creating a string representation of the matrix
+        \return string that is the string representation of the matrix
+    */
+    std::string toString() const;
+
+    /**
+        \brief Method for converting the values into a ConcreteSquareMatrix
+        \return ConcreteSquareMatrix object holding the values, floating point values are rounded
+        \exception std::overflow_error Arithmetic overflow
+    */
+    ConcreteSquareMatrix toConcrete() const;
+
+    /**
+        \brief Getter for the size n of the matrix
+        \return unsigned int value of the attribute n
+    */
+    unsigned int getN() const;
+
+    /**
+        \brief Getter for a value of the matrix
+        \param i row index
+        \param j column index
+        \return T value at row i and column j
+    */
+    T at(unsigned int i, unsigned int j) const;
+
+    /**
+        \brief Getter for the row-major values of the matrix
+        \return Reference to the vector of the values
+    */
+    const std::vector<T>& data() const;
+
+    /**
+        \brief Method for creating a new matrix that is a transpose of the matrix
+        \tparam T scalar type of the matrix
+        \return NumericSquareMatrix object that is the transpose of the matrix
+    */
+    NumericSquareMatrix<T> transpose() const;
+
+    /**
+        \brief Method for transposing the matrix in place
+        \tparam T scalar type of the matrix
+        \return Reference to the NumericSquareMatrix object that has been transposed
+    */
+    NumericSquareMatrix<T>& transposeInPlace();
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a NumericSquareMatrix object to compare to
+        \tparam T scalar type of the matrix
+        \return Boolean value of the comparison
+    */
+    bool operator ==(const NumericSquareMatrix<T>& rhs) const;
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a NumericSquareMatrix object that is the matrix to add
+        \tparam T scalar type of the matrix
+        \return Reference to a NumericSquareMatrix object that is the result of the addition
+        \exception std::invalid_argument Incompatible matrices
+    */
+    NumericSquareMatrix<T>& operator +=(const NumericSquareMatrix<T>& rhs);
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a NumericSquareMatrix object that is the matrix to subtract
+        \tparam T scalar type of the matrix
+        \return Reference to a NumericSquareMatrix object that is the result of the subtraction
+        \exception std::invalid_argument Incompatible matrices
+    */
+    NumericSquareMatrix<T>& operator -=(const NumericSquareMatrix<T>& rhs);
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a NumericSquareMatrix object that is the matrix to multiply with
+        \tparam T scalar type of the matrix
+        \return Reference to a NumericSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+    */
+    NumericSquareMatrix<T>& operator *=(const NumericSquareMatrix<T>& rhs);
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a NumericSquareMatrix object that is the right hand side of the addition
+        \tparam T scalar type of the matrix
+        \return NumericSquareMatrix object that is the result of the addition
+        \exception std::invalid_argument Incompatible matrices
+    */
+    NumericSquareMatrix<T> operator +(const NumericSquareMatrix<T>& rhs) const;
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a NumericSquareMatrix object that is the right hand side of the subtraction
+        \tparam T scalar type of the matrix
+        \return NumericSquareMatrix object that is the result of the subtraction
+        \exception std::invalid_argument Incompatible matrices
+    */
+    NumericSquareMatrix<T> operator -(const NumericSquareMatrix<T>& rhs) const;
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a NumericSquareMatrix object that is the right hand side of the multiplication
+        \tparam T scalar type of the matrix
+        \return NumericSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+    */
+    NumericSquareMatrix<T> operator *(const NumericSquareMatrix<T>& rhs) const;
+
+private:
+    unsigned int n;
+
+    std::vector<T> vals;
+};
+
+/**
+    \class Int32SquareMatrix
+    \brief Class for a matrix of 32-bit integers
+*/
+using Int32SquareMatrix = NumericSquareMatrix<int>;
+
+/**
+    \class Int64SquareMatrix
+    \brief Class for a matrix of 64-bit integers
+*/
+using Int64SquareMatrix = NumericSquareMatrix<long long>;
+
+/**
+    \class FloatSquareMatrix
+    \brief Class for a matrix of single precision floating point numbers
+*/
+using FloatSquareMatrix = NumericSquareMatrix<float>;
+
+/**
+    \class DoubleSquareMatrix
+    \brief Class for a matrix of double precision floating point numbers
+*/
+using DoubleSquareMatrix = NumericSquareMatrix<double>;
+
+template<typename T>
+NumericSquareMatrix<T>::NumericSquareMatrix() : n(0) {}
+
+template<typename T>
+NumericSquareMatrix<T>::NumericSquareMatrix(const std::string& str_m)
+{
+    if (!parseNumericSquareMatrix(str_m, n, vals))
+        throw std::invalid_argument("Not a square matrix");
+}
+
+template<typename T>
+NumericSquareMatrix<T>::NumericSquareMatrix(unsigned int size, std::vector<T> v) : n(size), vals(std::move(v))
+{
+    if (vals.size() != static_cast<std::size_t>(n) * n)
+        throw std::invalid_argument("Not a square matrix");
+}
+
+template<typename T>
+NumericSquareMatrix<T>::NumericSquareMatrix(const ConcreteSquareMatrix& m) : n(m.getN())
+{
+    std::vector<long long> v = m.values();
+    vals.assign(v.begin(), v.end());
+}
+
+template<typename T>
+std::string NumericSquareMatrix<T>::toString() const
+{
+    // Initialize the string
+    std::string str = "[";
+
+    // Empty matrix case
+    if (n == 0)
+        str.append("[]]");
+
+    else
+    {
+        // to_chars gives the shortest representation that parses back to the same value
+        char buf[64];
+        for (unsigned int i = 0; i < n; i++)
+        {
+            str.push_back('[');
+            for (unsigned int j = 0; j < n; j++)
+            {
+                auto res = std::to_chars(buf, buf + sizeof(buf), vals[i * n + j]);
+                str.append(buf, res.ptr);
+                str.push_back(',');
+            }
+
+            // Remove last ',' and close the row
+            str.pop_back();
+            str.push_back(']');
+        }
+        // Close the matrix
+        str.push_back(']');
+    }
+
+    return str;
+}
+
+template<typename T>
+ConcreteSquareMatrix NumericSquareMatrix<T>::toConcrete() const
+{
+    std::vector<long long> res(vals.size());
+    for (std::size_t i = 0; i < vals.size(); i++)
+    {
+        if (std::is_floating_point<T>::value)
+        {
+            // Values that do not even fit into 64 bits are reported like any other overflow
+            if (!(std::fabs(vals[i]) < 9.2e18))
+                throw std::overflow_error("Arithmetic overflow");
+            res[i] = std::llround(vals[i]);
+        }
+        else
+            res[i] = static_cast<long long>(vals[i]);
+    }
+    narrowKernel(res.data(), res.size(), ArithmeticPolicy::Widening);
+
+    return ConcreteSquareMatrix::fromValues(n, res);
+}
+
+template<typename T>
+unsigned int NumericSquareMatrix<T>::getN() const { return n; }
+
+template<typename T>
+T NumericSquareMatrix<T>::at(unsigned int i, unsigned int j) const { return vals[i * n + j]; }
+
+template<typename T>
+const std::vector<T>& NumericSquareMatrix<T>::data() const { return vals; }
+
+template<typename T>
+NumericSquareMatrix<T> NumericSquareMatrix<T>::transpose() const
+{
+    NumericSquareMatrix<T> m{ n, std::vector<T>(vals.size()) };
+    transposeKernel(vals.data(), m.vals.data(), n);
+    return m;
+}
+
+template<typename T>
+NumericSquareMatrix<T>& NumericSquareMatrix<T>::transposeInPlace()
+{
+    T* v = vals.data();
+    const unsigned int size = n;
+    auto swapCells = [v, size](unsigned int i, unsigned int j) { std::swap(v[i * size + j], v[j * size + i]); };
+    transposeInPlaceKernel(0, n, swapCells);
+    return *this;
+}
+
+template<typename T>
+bool NumericSquareMatrix<T>::operator ==(const NumericSquareMatrix<T>& rhs) const
+{
+    return n == rhs.n && vals == rhs.vals;
+}
+
+template<typename T>
+NumericSquareMatrix<T>& NumericSquareMatrix<T>::operator +=(const NumericSquareMatrix<T>& rhs)
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    addKernel(vals.data(), rhs.vals.data(), vals.size());
+    return *this;
+}
+
+template<typename T>
+NumericSquareMatrix<T>& NumericSquareMatrix<T>::operator -=(const NumericSquareMatrix<T>& rhs)
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    subtractKernel(vals.data(), rhs.vals.data(), vals.size());
+    return *this;
+}
+
+template<typename T>
+NumericSquareMatrix<T>& NumericSquareMatrix<T>::operator *=(const NumericSquareMatrix<T>& rhs)
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Strassen-Winograd would change the rounding of floating point types,
+    // so every instantiation uses the classical blocked kernel
+    std::vector<T> res(vals.size());
+    blockedMultiplyKernel(vals.data(), rhs.vals.data(), res.data(), n);
+    vals.swap(res);
+    return *this;
+}
+
+template<typename T>
+NumericSquareMatrix<T> NumericSquareMatrix<T>::operator +(const NumericSquareMatrix<T>& rhs) const
+{
+    NumericSquareMatrix<T> res{ *this };
+    res += rhs;
+    return res;
+}
+
+template<typename T>
+NumericSquareMatrix<T> NumericSquareMatrix<T>::operator -(const NumericSquareMatrix<T>& rhs) const
+{
+    NumericSquareMatrix<T> res{ *this };
+    res -= rhs;
+    return res;
+}
+
+template<typename T>
+NumericSquareMatrix<T> NumericSquareMatrix<T>::operator *(const NumericSquareMatrix<T>& rhs) const
+{
+    NumericSquareMatrix<T> res{ *this };
+    res *= rhs;
+    return res;
+}
+
+/**
+    \brief Operator for output
+    \param os stream to print in
+    \param m reference to a NumericSquareMatrix object
+    \tparam T scalar type of the matrix
+*/
+template<typename T>
+std::ostream& operator <<(std::ostream& os, const NumericSquareMatrix<T>& m)
+{
+    return os << m.toString();
+}
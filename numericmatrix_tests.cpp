@@ -0,0 +1,68 @@
+/**
+    \file numericmatrix_tests.cpp
+    \brief Unit tests for the NumericSquareMatrix class template
+*/
+
+#include "catch.hpp"
+#include "numericmatrix.h"
+
+TEST_CASE("NumericSquareMatrix parametric constructor test", "[NumericSquareMatrix]")
+{
+    DoubleSquareMatrix d{ "[[1.5,-2][0.1,3e2]]" };
+    CHECK(d.toString() == "[[1.5,-2][0.1,300]]");
+    CHECK(d.getN() == 2);
+    CHECK(d.at(1, 0) == 0.1);
+    Int64SquareMatrix l{ "[[9000000000,1][-9000000000,0]]" };
+    CHECK(l.toString() == "[[9000000000,1][-9000000000,0]]");
+    CHECK(Int32SquareMatrix{ "[]" }.toString() == "[[]]");
+    CHECK(Int32SquareMatrix{ "[[]]" }.getN() == 0);
+    CHECK(FloatSquareMatrix{ 1, { 0.25f } }.toString() == "[[0.25]]");
+    CHECK_THROWS_WITH(Int32SquareMatrix{ "[[1.5]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(Int32SquareMatrix{ "[[1,2][3]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(Int32SquareMatrix{ "[[1,2][3,4][5,6]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(DoubleSquareMatrix{ "[[1,]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(DoubleSquareMatrix{ "" }, "Not a square matrix");
+    CHECK_THROWS_WITH((DoubleSquareMatrix{ 2, { 1.0 } }), "Not a square matrix");
+}
+
+TEST_CASE("NumericSquareMatrix arithmetic operator test", "[NumericSquareMatrix]")
+{
+    Int32SquareMatrix i1{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    Int32SquareMatrix i2{ "[[-5,0,-2][1,2,3][0,-7,0]]" };
+    CHECK((i1 + i2).toString() == "[[-2,-1,2][-6,0,2][6,-7,1]]");
+    CHECK((i1 - i2).toString() == "[[8,-1,6][-8,-4,-4][6,7,1]]");
+    CHECK((i1 * i2).toString() == "[[-16,-30,-9][33,3,8][-30,-7,-12]]");
+
+    DoubleSquareMatrix d1{ "[[0.5,1][2,-1.5]]" };
+    DoubleSquareMatrix d2{ "[[2,0.25][-1,4]]" };
+    CHECK((d1 + d2).toString() == "[[2.5,1.25][1,2.5]]");
+    CHECK((d1 - d2).toString() == "[[-1.5,0.75][3,-5.5]]");
+    CHECK((d1 * d2).toString() == "[[0,4.125][5.5,-5.5]]");
+    CHECK((d1 *= d2).toString() == "[[0,4.125][5.5,-5.5]]");
+
+    Int64SquareMatrix l{ "[[3000000000,0][0,3000000000]]" };
+    CHECK((l * l).toString() == "[[9000000000000000000,0][0,9000000000000000000]]");
+
+    FloatSquareMatrix f{ "[[1]]" };
+    CHECK_THROWS_WITH(f + FloatSquareMatrix{ "[[1,2][3,4]]" }, "Incompatible matrices");
+    CHECK_THROWS_AS(f * FloatSquareMatrix{ "[[]]" }, std::invalid_argument);
+}
+
+TEST_CASE("NumericSquareMatrix transpose method test", "[NumericSquareMatrix]")
+{
+    DoubleSquareMatrix d{ "[[1,2,3][4,5,6][7,8,9.5]]" };
+    CHECK(d.transpose().toString() == "[[1,4,7][2,5,8][3,6,9.5]]");
+    CHECK(d.transposeInPlace().toString() == "[[1,4,7][2,5,8][3,6,9.5]]");
+    CHECK(d.toString() == "[[1,4,7][2,5,8][3,6,9.5]]");
+}
+
+TEST_CASE("NumericSquareMatrix ConcreteSquareMatrix conversion test", "[NumericSquareMatrix]")
+{
+    ConcreteSquareMatrix c{ "[[3,-1][-7,2]]" };
+    DoubleSquareMatrix d{ c };
+    CHECK(d.toString() == "[[3,-1][-7,2]]");
+    CHECK(d.toConcrete() == c);
+    CHECK(DoubleSquareMatrix{ "[[2.4,-2.6][0.5,-0.5]]" }.toConcrete().toString() == "[[2,-3][1,-1]]");
+    CHECK_THROWS_AS(Int64SquareMatrix{ "[[3000000000]]" }.toConcrete(), std::overflow_error);
+    CHECK_THROWS_AS(DoubleSquareMatrix{ "[[1e300]]" }.toConcrete(), std::overflow_error);
+}
@@ -0,0 +1,165 @@
+/**
+    \file operationtimer.cpp
+    \brief Implementation of the OperationTimer class
+*/
+
+#include "operationtimer.h"
+#include <atomic>
+#include <algorithm>
+
+namespace
+{
+    const std::size_t operations = static_cast<std::size_t>(TimedOperation::IsSymbolicSquareMatrix) + 1;
+
+    // Latencies below 8 ns get a bucket each, above that every power of two is split into 8 buckets
+    const unsigned int subBuckets = 8;
+
+    const unsigned int latencyBuckets = subBuckets * 62;
+
+    struct Histogram
+    {
+        std::atomic<unsigned long long> counts[latencyBuckets];
+
+        std::atomic<unsigned long long> count;
+
+        std::atomic<unsigned long long> max;
+    };
+
+    // Zero initialized before any code runs
+    Histogram histograms[operations][OperationTimer::sizeBuckets];
+
+    unsigned int latencyBucket(unsigned long long ns)
+    {
+        if (ns < subBuckets)
+            return static_cast<unsigned int>(ns);
+
+        // The three bits below the highest set bit select the sub-bucket
+        const unsigned int exponent = 63 - __builtin_clzll(ns);
+        const unsigned int sub = static_cast<unsigned int>(ns >> (exponent - 3)) & (subBuckets - 1);
+        return std::min((exponent - 2) * subBuckets + sub, latencyBuckets - 1);
+    }
+
+    unsigned long long upperBound(unsigned int b)
+    {
+        if (b < subBuckets)
+            return b;
+        const unsigned int exponent = b / subBuckets + 2;
+        const unsigned long long sub = b % subBuckets;
+        return ((subBuckets + sub + 1) << (exponent - 3)) - 1;
+    }
+
+    unsigned long long percentile(const Histogram& h, unsigned long long count, unsigned long long max, double q)
+    {
+        const unsigned long long rank = std::max(1ULL, static_cast<unsigned long long>(q * count + 0.999999));
+        unsigned long long seen = 0;
+        for (unsigned int b = 0; b < latencyBuckets; b++)
+        {
+            seen += h.counts[b].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return std::min(upperBound(b), max);
+        }
+        return max;
+    }
+}
+
+bool OperationTimer::available()
+{
+#ifdef MATRIX_TIMERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned int OperationTimer::bucket(std::size_t size)
+{
+    unsigned int b = 0;
+    while (size > 0 && b < sizeBuckets - 1)
+    {
+        size >>= 1;
+        b++;
+    }
+    return b;
+}
+
+void OperationTimer::record(TimedOperation op, std::size_t size, unsigned long long ns)
+{
+    Histogram& h = histograms[static_cast<std::size_t>(op)][bucket(size)];
+    h.counts[latencyBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+    h.count.fetch_add(1, std::memory_order_relaxed);
+
+    unsigned long long max = h.max.load(std::memory_order_relaxed);
+    while (ns > max && !h.max.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        ;
+}
+
+LatencyStats OperationTimer::stats(TimedOperation op, unsigned int bucket)
+{
+    const Histogram& h = histograms[static_cast<std::size_t>(op)][std::min(bucket, sizeBuckets - 1)];
+    LatencyStats s;
+    s.count = h.count.load(std::memory_order_relaxed);
+    s.max = h.max.load(std::memory_order_relaxed);
+    if (s.count > 0)
+    {
+        s.p50 = percentile(h, s.count, s.max, 0.50);
+        s.p99 = percentile(h, s.count, s.max, 0.99);
+    }
+    return s;
+}
+
+void OperationTimer::reset()
+{
+    for (auto& row : histograms)
+    {
+        for (Histogram& h : row)
+        {
+            for (auto& c : h.counts)
+                c.store(0, std::memory_order_relaxed);
+            h.count.store(0, std::memory_order_relaxed);
+            h.max.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::string OperationTimer::name(TimedOperation op)
+{
+    switch (op)
+    {
+    case TimedOperation::Parse: return "parse";
+    case TimedOperation::Add: return "add";
+    case TimedOperation::Subtract: return "subtract";
+    case TimedOperation::Multiply: return "multiply";
+    case TimedOperation::Evaluate: return "evaluate";
+    case TimedOperation::ToString: return "toString";
+    case TimedOperation::IsSquareMatrix: return "isSquareMatrix";
+    default: return "isSymbolicSquareMatrix";
+    }
+}
+
+std::string OperationTimer::report()
+{
+    if (!available())
+        return "Timing is not available";
+
+    std::string str;
+    for (std::size_t op = 0; op < operations; op++)
+    {
+        for (unsigned int b = 0; b < sizeBuckets; b++)
+        {
+            const LatencyStats s = stats(static_cast<TimedOperation>(op), b);
+            if (s.count == 0)
+                continue;
+
+            // Bucket b holds the sizes from 2^(b-1) to 2^b - 1
+            std::string sizes = b < 2 ? std::to_string(b) : std::to_string(1ULL << (b - 1)) + "-" + std::to_string((1ULL << b) - 1);
+            if (b == sizeBuckets - 1)
+                sizes = std::to_string(1ULL << (b - 1)) + "+";
+            if (!str.empty())
+                str.push_back('\n');
+            str.append(name(static_cast<TimedOperation>(op)) + " size " + sizes + ": " + std::to_string(s.count) + " calls, p50 "
+                + std::to_string(s.p50) + " ns, p99 " + std::to_string(s.p99) + " ns, max " + std::to_string(s.max) + " ns");
+        }
+    }
+
+    return str.empty() ? "No operations timed" : str;
+}
@@ -0,0 +1,164 @@
+/**
+    \file operationtimer.h
+    \brief Header for the OperationTimer class
+*/
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#ifdef MATRIX_TIMERS
+#include <chrono>
+#endif
+
+/**
+    \brief Operations the latencies are collected for
+*/
+enum class TimedOperation
+{
+    Parse,                 ///< Constructing a matrix from a string
+    Add,                   ///< Operator +
+    Subtract,              ///< Operator -
+    Multiply,              ///< Operator *
+    Evaluate,              ///< Evaluating a matrix
+    ToString,              ///< Creating the string representation of a matrix
+    IsSquareMatrix,        ///< Validating a concrete matrix string
+    IsSymbolicSquareMatrix ///< Validating a symbolic matrix string
+};
+
+/**
+    \struct LatencyStats
+    \brief Defines the latency summary of one operation and size bucket in nanoseconds
+
+    The percentiles are the upper bounds of histogram buckets, which are at
+    most an eighth wider than their lower bounds.
+*/
+struct LatencyStats
+{
+    unsigned long long count = 0;
+
+    unsigned long long p50 = 0;
+
+    unsigned long long p99 = 0;
+
+    unsigned long long max = 0;
+};
+
+/**
+    \class OperationTimer
+    \brief Defines the latency histograms of the hot matrix operations
+
+    Timing is switched on at compile time: only a program built with
+    MATRIX_TIMERS defined in every translation unit reads the clock.
+    Otherwise the scopes compile to nothing and every histogram stays empty.
+
+    The size is n for the matrix operations and the string length for
+    parsing and the validators. Sizes are grouped into the buckets 0, 1,
+    2-3, 4-7 and so on, and the last bucket holds every larger size.
+*/
+class OperationTimer
+{
+public:
+    /**
+        \brief Number of size buckets
+    */
+    static const unsigned int sizeBuckets = 24;
+
+    /**
+        \class Scope
+        \brief Defines a latency measurement from the construction to the destruction of the object
+    */
+    class Scope
+    {
+    public:
+        /**
+            \brief Parametric constructor
+            \param op operation to time
+            \param size size of the operation
+        */
+        Scope(TimedOperation op, std::size_t size)
+#ifdef MATRIX_TIMERS
+            : op(op), size(size), start(std::chrono::steady_clock::now()) {}
+
+        ~Scope() { record(op, size, std::chrono::steady_clock::now() - start); }
+#else
+        {
+            (void)op;
+            (void)size;
+        }
+#endif
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator =(const Scope&) = delete;
+
+#ifdef MATRIX_TIMERS
+    private:
+        TimedOperation op;
+
+        std::size_t size;
+
+        std::chrono::steady_clock::time_point start;
+#endif
+    };
+
+    /**
+        \brief Getter for whether the program times the operations
+        \return Boolean value telling whether MATRIX_TIMERS was defined
+    */
+    static bool available();
+
+    /**
+        \brief Method for adding one latency to a histogram
+        \param op timed operation
+        \param size size of the operation
+        \param ns latency in nanoseconds
+    */
+    static void record(TimedOperation op, std::size_t size, unsigned long long ns);
+
+#ifdef MATRIX_TIMERS
+    /**
+        \brief Method for adding one latency to a histogram
+        \param op timed operation
+        \param size size of the operation
+        \param elapsed latency
+    */
+    static void record(TimedOperation op, std::size_t size, std::chrono::steady_clock::duration elapsed)
+    {
+        record(op, size, static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+#endif
+
+    /**
+        \brief Getter for the size bucket of a size
+        \param size size of an operation
+        \return unsigned int index of the bucket
+    */
+    static unsigned int bucket(std::size_t size);
+
+    /**
+        \brief Getter for the latency summary of one operation and size bucket
+        \param op timed operation
+        \param bucket index of the size bucket
+        \return LatencyStats object of the histogram
+    */
+    static LatencyStats stats(TimedOperation op, unsigned int bucket);
+
+    /**
+        \brief Method for emptying every histogram
+    */
+    static void reset();
+
+    /**
+        \brief Getter for the name of an operation
+        \param op timed operation
+        \return string such as "multiply"
+    */
+    static std::string name(TimedOperation op);
+
+    /**
+        \brief Method for creating a report of every histogram that is not empty
+        \return string with one line per operation and size bucket
+    */
+    static std::string report();
+};
@@ -0,0 +1,68 @@
+/**
+    \file operationtimer_tests.cpp
+    \brief Unit tests for the OperationTimer class
+*/
+
+#include "catch.hpp"
+#include "operationtimer.h"
+#include "elementarymatrix.h"
+
+TEST_CASE("OperationTimer histogram test", "[OperationTimer]")
+{
+    CHECK(OperationTimer::bucket(0) == 0);
+    CHECK(OperationTimer::bucket(1) == 1);
+    CHECK(OperationTimer::bucket(3) == 2);
+    CHECK(OperationTimer::bucket(4) == 3);
+    CHECK(OperationTimer::bucket(1000) == 10);
+    CHECK(OperationTimer::bucket(static_cast<std::size_t>(-1)) == OperationTimer::sizeBuckets - 1);
+
+    OperationTimer::reset();
+    CHECK(OperationTimer::stats(TimedOperation::Evaluate, 3).count == 0);
+
+    // 98 fast calls and 2 slow ones
+    for (int i = 0; i < 98; i++)
+        OperationTimer::record(TimedOperation::Evaluate, 5, 1000);
+    OperationTimer::record(TimedOperation::Evaluate, 6, 50000);
+    OperationTimer::record(TimedOperation::Evaluate, 7, 3);
+
+    LatencyStats s = OperationTimer::stats(TimedOperation::Evaluate, 3);
+    CHECK(s.count == 100);
+    CHECK(s.p50 >= 1000);
+    CHECK(s.p50 < 1000 * 9 / 8);
+    CHECK(s.p99 >= 1000);
+    CHECK(s.p99 < 1000 * 9 / 8);
+    CHECK(s.max == 50000);
+
+    // Other sizes and operations have histograms of their own
+    OperationTimer::record(TimedOperation::Evaluate, 64, 7);
+    CHECK(OperationTimer::stats(TimedOperation::Evaluate, 7).p50 == 7);
+    CHECK(OperationTimer::stats(TimedOperation::Evaluate, 3).count == 100);
+    CHECK(OperationTimer::stats(TimedOperation::Multiply, 3).count == 0);
+
+    CHECK(OperationTimer::name(TimedOperation::Multiply) == "multiply");
+    if (OperationTimer::available())
+        CHECK(OperationTimer::report().find("evaluate size 4-7: 100 calls, p50 ") != std::string::npos);
+    else
+        CHECK(OperationTimer::report() == "Timing is not available");
+
+    OperationTimer::reset();
+    CHECK(OperationTimer::stats(TimedOperation::Evaluate, 3).count == 0);
+}
+
+TEST_CASE("OperationTimer scope test", "[OperationTimer]")
+{
+    OperationTimer::reset();
+    ConcreteSquareMatrix a{ "[[1,2][3,4]]" };
+    ConcreteSquareMatrix b = a * a;
+    ConcreteSquareMatrix c = b + a - a;
+    std::string str = c.toString();
+
+    const unsigned long long expected = OperationTimer::available() ? 1 : 0;
+    CHECK(OperationTimer::stats(TimedOperation::Multiply, OperationTimer::bucket(2)).count == expected);
+    CHECK(OperationTimer::stats(TimedOperation::Add, OperationTimer::bucket(2)).count == expected);
+    CHECK(OperationTimer::stats(TimedOperation::Subtract, OperationTimer::bucket(2)).count == expected);
+    CHECK(OperationTimer::stats(TimedOperation::ToString, OperationTimer::bucket(2)).count == expected);
+    CHECK(OperationTimer::stats(TimedOperation::Parse, OperationTimer::bucket(12)).count == expected);
+    CHECK(OperationTimer::stats(TimedOperation::IsSquareMatrix, OperationTimer::bucket(12)).count == expected);
+    OperationTimer::reset();
+}
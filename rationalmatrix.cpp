@@ -0,0 +1,346 @@
+/**
+    \file rationalmatrix.cpp
+    \brief Implementation of the RationalSquareMatrix class and the exact inverse and solve functions
+*/
+
+#include "rationalmatrix.h"
+#include "modularmatrix.h"
+#include <numeric>
+#include <future>
+#include <cmath>
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+#if defined(__SIZEOF_INT128__)
+    using Wide = unsigned __int128;
+#else
+    using Wide = unsigned long long;
+#endif
+
+    // Enough primes below 2^31 for a product above twice the 64-bit range
+    const unsigned int maxPrimes = sizeof(Wide) == 16 ? 3 : 2;
+
+    // Residues of a solution modulo one prime
+    struct ModularSolution
+    {
+        unsigned int p;
+
+        unsigned int det;
+
+        // det * A^-1 * R modulo p, n x m values
+        std::vector<unsigned int> x;
+    };
+
+    unsigned int powMod(unsigned long long b, unsigned int e, const BarrettReducer& r)
+    {
+        unsigned long long res = 1;
+        while (e > 0)
+        {
+            if (e & 1)
+                res = r.reduce(res * b);
+            b = r.reduce(b * b);
+            e >>= 1;
+        }
+        return static_cast<unsigned int>(res);
+    }
+
+    unsigned int residue(long long v, unsigned int p)
+    {
+        long long r = v % static_cast<long long>(p);
+        return static_cast<unsigned int>(r < 0 ? r + p : r);
+    }
+
+    // Gauss-Jordan elimination of [A | R] modulo p, the determinant is 0 when A is singular modulo p
+    ModularSolution solveModPrime(const std::vector<long long>& a, const std::vector<long long>& rhs, unsigned int n, unsigned int m, unsigned int p)
+    {
+        const BarrettReducer red{ p };
+        const unsigned int w = n + m;
+        std::vector<unsigned long long> t(static_cast<std::size_t>(n) * w);
+        for (unsigned int i = 0; i < n; i++)
+        {
+            for (unsigned int j = 0; j < n; j++)
+                t[i * w + j] = residue(a[i * n + j], p);
+            for (unsigned int j = 0; j < m; j++)
+                t[i * w + n + j] = residue(rhs[i * m + j], p);
+        }
+
+        ModularSolution s{ p, 1, {} };
+        for (unsigned int k = 0; k < n; k++)
+        {
+            unsigned int piv = k;
+            while (piv < n && t[piv * w + k] == 0)
+                piv++;
+            if (piv == n)
+            {
+                s.det = 0;
+                return s;
+            }
+            if (piv != k)
+            {
+                std::swap_ranges(t.begin() + piv * w, t.begin() + (piv + 1) * w, t.begin() + k * w);
+                s.det = s.det ? p - s.det : 0;
+            }
+            s.det = red.reduce(static_cast<unsigned long long>(s.det) * t[k * w + k]);
+
+            // Normalize the pivot row, then clear the pivot column in every other row
+            const unsigned long long inv = powMod(t[k * w + k], p - 2, red);
+            for (unsigned int j = k; j < w; j++)
+                t[k * w + j] = red.reduce(t[k * w + j] * inv);
+            for (unsigned int i = 0; i < n; i++)
+            {
+                const unsigned long long f = t[i * w + k];
+                if (i == k || f == 0)
+                    continue;
+                for (unsigned int j = k; j < w; j++)
+                    t[i * w + j] = red.reduce(t[i * w + j] + (p - f) * t[k * w + j]);
+            }
+        }
+
+        // Scaling A^-1 R by the determinant gives the integer adj(A) R
+        s.x.resize(static_cast<std::size_t>(n) * m);
+        for (unsigned int i = 0; i < n; i++)
+            for (unsigned int j = 0; j < m; j++)
+                s.x[i * m + j] = red.reduce(t[i * w + n + j] * s.det);
+
+        return s;
+    }
+
+    // Garner's mixed radix reconstruction into the symmetric range around zero
+    long long reconstruct(const std::vector<ModularSolution>& sols, const std::vector<std::vector<unsigned int>>& inv, std::size_t idx, bool det)
+    {
+        const std::size_t k = sols.size();
+        unsigned int c[4];
+        Wide value = 0;
+        Wide radix = 1;
+        for (std::size_t i = 0; i < k; i++)
+        {
+            const unsigned long long p = sols[i].p;
+            unsigned long long t = det ? sols[i].det : sols[i].x[idx];
+            for (std::size_t j = 0; j < i; j++)
+                t = (t + p - c[j] % p) % p * inv[j][i] % p;
+            c[i] = static_cast<unsigned int>(t);
+            value += radix * c[i];
+            radix *= p;
+        }
+
+        // radix now holds the product of the primes
+        if (value > radix / 2)
+        {
+            const Wide mag = radix - value;
+            if (mag > static_cast<Wide>(LLONG_MAX))
+                throw std::overflow_error("Arithmetic overflow");
+            return -static_cast<long long>(mag);
+        }
+        if (value > static_cast<Wide>(LLONG_MAX))
+            throw std::overflow_error("Arithmetic overflow");
+        return static_cast<long long>(value);
+    }
+
+    // Checks A X = d R exactly, an intermediate outside 64 bits counts as a failure
+    bool verify(const std::vector<long long>& a, const std::vector<long long>& rhs, const std::vector<long long>& x, long long d, unsigned int n, unsigned int m)
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            for (unsigned int j = 0; j < m; j++)
+            {
+                long long sum = 0;
+                long long prod;
+                for (unsigned int k = 0; k < n; k++)
+                    if (__builtin_mul_overflow(a[i * n + k], x[k * m + j], &prod) || __builtin_add_overflow(sum, prod, &sum))
+                        return false;
+                if (__builtin_mul_overflow(d, rhs[i * m + j], &prod) || sum != prod)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Finds x and d != 0 with A x = d R, the primes are eliminated in parallel
+    void exactSolve(const std::vector<long long>& a, const std::vector<long long>& rhs, unsigned int n, unsigned int m, std::vector<long long>& x, long long& d)
+    {
+        // Hadamard's bound on the minors of [A | R] covers the determinant and adj(A) R
+        long double bits = 0;
+        for (unsigned int i = 0; i < n; i++)
+        {
+            long double norm = 1;
+            for (unsigned int j = 0; j < n; j++)
+                norm += static_cast<long double>(a[i * n + j]) * a[i * n + j];
+            for (unsigned int j = 0; j < m; j++)
+                norm += static_cast<long double>(rhs[i * m + j]) * rhs[i * m + j];
+            bits += std::log2(norm) / 2;
+        }
+
+        // Each prime gives almost 31 bits, one more bit is needed for the sign
+        const unsigned int needed = static_cast<unsigned int>(std::ceil((bits + 2) / 30.9L));
+        const unsigned int k = std::max(1u, std::min(needed, maxPrimes));
+
+        std::vector<ModularSolution> sols;
+        long double zeroBits = 0;
+        unsigned int next = 2147483647u;
+        while (sols.size() < k)
+        {
+            std::vector<std::future<ModularSolution>> round;
+            while (sols.size() + round.size() < k)
+            {
+                next = previousPrime(next);
+                round.push_back(std::async(std::launch::async, solveModPrime, std::cref(a), std::cref(rhs), n, m, next));
+                next--;
+            }
+
+            for (auto& f : round)
+            {
+                ModularSolution s = f.get();
+                if (s.det != 0)
+                    sols.push_back(std::move(s));
+
+                // A determinant divisible by more primes than its bound allows is zero
+                else if ((zeroBits += std::log2(static_cast<long double>(s.p))) > bits + 1)
+                    throw std::invalid_argument("Singular matrix");
+            }
+        }
+
+        std::vector<std::vector<unsigned int>> inv(k, std::vector<unsigned int>(k));
+        for (unsigned int i = 0; i < k; i++)
+            for (unsigned int j = 0; j < k; j++)
+                if (i != j)
+                    inv[i][j] = powMod(sols[i].p % sols[j].p, sols[j].p - 2, BarrettReducer{ sols[j].p });
+
+        d = reconstruct(sols, inv, 0, true);
+        x.resize(static_cast<std::size_t>(n) * m);
+        for (std::size_t i = 0; i < x.size(); i++)
+            x[i] = reconstruct(sols, inv, i, false);
+
+        // Without enough primes for the bound the result has to prove itself
+        if (needed > k && !verify(a, rhs, x, d, n, m))
+            throw std::overflow_error("Arithmetic overflow");
+    }
+}
+
+std::string Fraction::toString() const
+{
+    return den == 1 ? std::to_string(num) : std::to_string(num) + "/" + std::to_string(den);
+}
+
+RationalSquareMatrix::RationalSquareMatrix(unsigned int size, std::vector<long long> numerators, long long denominator)
+    : n(size), num(std::move(numerators)), den(denominator)
+{
+    if (num.size() != static_cast<std::size_t>(n) * n || den == 0)
+        throw std::invalid_argument("Not a square matrix");
+
+    // Lowest terms with a positive denominator
+    long long g = den;
+    for (long long v : num)
+        g = std::gcd(g, v);
+    if (den < 0)
+        g = -g;
+    den /= g;
+    for (long long& v : num)
+        v /= g;
+}
+
+unsigned int RationalSquareMatrix::getN() const { return n; }
+
+long long RationalSquareMatrix::denominator() const { return den; }
+
+const std::vector<long long>& RationalSquareMatrix::numerators() const { return num; }
+
+Fraction RationalSquareMatrix::at(unsigned int i, unsigned int j) const
+{
+    const long long v = num[i * n + j];
+    const long long g = std::gcd(v, den);
+    return Fraction{ v / g, den / g };
+}
+
+std::string RationalSquareMatrix::toString() const
+{
+    // Initialize the string
+    std::string str = "[";
+
+    // Empty matrix case
+    if (n == 0)
+        str.append("[]]");
+
+    else
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            str.push_back('[');
+            for (unsigned int j = 0; j < n; j++)
+            {
+                str.append(at(i, j).toString());
+                str.push_back(',');
+            }
+
+            // Remove last ',' and close the row
+            str.pop_back();
+            str.push_back(']');
+        }
+        // Close the matrix
+        str.push_back(']');
+    }
+
+    return str;
+}
+
+bool RationalSquareMatrix::operator ==(const RationalSquareMatrix& rhs) const
+{
+    return n == rhs.n && den == rhs.den && num == rhs.num;
+}
+
+RationalSquareMatrix inverse(const ConcreteSquareMatrix& a)
+{
+    const unsigned int n = a.getN();
+    std::vector<long long> id(static_cast<std::size_t>(n) * n, 0);
+    for (unsigned int i = 0; i < n; i++)
+        id[i * n + i] = 1;
+
+    return solve(a, ConcreteSquareMatrix::fromValues(n, id));
+}
+
+RationalSquareMatrix solve(const ConcreteSquareMatrix& a, const ConcreteSquareMatrix& b)
+{
+    // Check dimensions
+    const unsigned int n = a.getN();
+    if (b.getN() != n)
+        throw std::invalid_argument("Incompatible matrices");
+    if (n == 0)
+        return RationalSquareMatrix{ 0, {}, 1 };
+
+    std::vector<long long> x;
+    long long d;
+    exactSolve(a.values(), b.values(), n, n, x, d);
+    return RationalSquareMatrix{ n, std::move(x), d };
+}
+
+std::vector<Fraction> solve(const ConcreteSquareMatrix& a, const std::vector<long long>& b)
+{
+    // Check dimensions
+    const unsigned int n = a.getN();
+    if (b.size() != n)
+        throw std::invalid_argument("Incompatible matrices");
+    if (n == 0)
+        return {};
+
+    std::vector<long long> x;
+    long long d;
+    exactSolve(a.values(), b, n, 1, x, d);
+
+    std::vector<Fraction> res;
+    for (long long v : x)
+    {
+        long long g = std::gcd(v, d);
+        if (d < 0)
+            g = -g;
+        res.push_back(Fraction{ v / g, d / g });
+    }
+    return res;
+}
+
+std::ostream& operator <<(std::ostream& os, const RationalSquareMatrix& m)
+{
+    os << m.toString();
+    return os;
+}
@@ -0,0 +1,139 @@
+/**
+    \file rationalmatrix.h
+    \brief Header for the RationalSquareMatrix class and the exact inverse and solve functions
+*/
+
+#pragma once
+
+#include "elementarymatrix.h"
+#include <vector>
+#include <string>
+#include <ostream>
+
+/**
+    \struct Fraction
+    \brief Defines an exact rational value in lowest terms with a positive denominator
+*/
+struct Fraction
+{
+    long long num;
+
+    long long den;
+
+    /**
+        \brief Method for creating a string representation of the fraction
+        \return string such as "-3/4", or "5" when the denominator is 1
+    */
+    std::string toString() const;
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a Fraction object to compare to
+        \return Boolean value of the comparison
+    */
+    bool operator ==(const Fraction& rhs) const { return num == rhs.num && den == rhs.den; }
+};
+
+/**
+    \class RationalSquareMatrix
+    \brief Defines a class for a matrix of rational values sharing one denominator
+
+    The values are integer numerators over a common positive denominator,
+    reduced so that the numerators and the denominator have no common factor.
+*/
+class RationalSquareMatrix
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param size size n of the matrix
+        \param numerators vector of the size * size numerators in row-major order
+        \param denominator common nonzero denominator
+        \exception std::invalid_argument Not a square matrix
+    */
+    RationalSquareMatrix(unsigned int size, std::vector<long long> numerators, long long denominator);
+
+    /**
+        \brief Getter for the size n of the matrix
+        \return unsigned int value of the attribute n
+    */
+    unsigned int getN() const;
+
+    /**
+        \brief Getter for the common denominator
+        \return long long value of the denominator
+    */
+    long long denominator() const;
+
+    /**
+        \brief Getter for the numerators in row-major order
+        \return Reference to the vector of the numerators
+    */
+    const std::vector<long long>& numerators() const;
+
+    /**
+        \brief Getter for a value of the matrix
+        \param i row index
+        \param j column index
+        \return Fraction value at row i and column j in lowest terms
+    */
+    Fraction at(unsigned int i, unsigned int j) const;
+
+    /**
+        \brief Method for creating a string representation of the matrix
+        \return string such as "[[1/2,0][-1,3/2]]"
+    */
+    std::string toString() const;
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a RationalSquareMatrix object to compare to
+        \return Boolean value of the comparison
+    */
+    bool operator ==(const RationalSquareMatrix& rhs) const;
+
+private:
+    unsigned int n;
+
+    std::vector<long long> num;
+
+    long long den;
+};
+
+/**
+    \brief Function for the exact inverse of a matrix
+    \param a reference to a ConcreteSquareMatrix object
+    \return RationalSquareMatrix object that is the inverse of a
+    \exception std::invalid_argument Singular matrix
+    \exception std::overflow_error Arithmetic overflow
+*/
+RationalSquareMatrix inverse(const ConcreteSquareMatrix& a);
+
+/**
+    \brief Function for the exact solution X of AX = B
+    \param a reference to a ConcreteSquareMatrix object that is A
+    \param b reference to a ConcreteSquareMatrix object that is B
+    \return RationalSquareMatrix object that is X
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::invalid_argument Singular matrix
+    \exception std::overflow_error Arithmetic overflow
+*/
+RationalSquareMatrix solve(const ConcreteSquareMatrix& a, const ConcreteSquareMatrix& b);
+
+/**
+    \brief Function for the exact solution x of Ax = b
+    \param a reference to a ConcreteSquareMatrix object that is A
+    \param b reference to a vector of the n values of b
+    \return vector of the n values of x in lowest terms
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::invalid_argument Singular matrix
+    \exception std::overflow_error Arithmetic overflow
+*/
+std::vector<Fraction> solve(const ConcreteSquareMatrix& a, const std::vector<long long>& b);
+
+/**
+    \brief Operator for output
+    \param os stream to print in
+    \param m reference to a RationalSquareMatrix object
+*/
+std::ostream& operator <<(std::ostream& os, const RationalSquareMatrix& m);
@@ -0,0 +1,68 @@
+/**
+    \file rationalmatrix_tests.cpp
+    \brief Unit tests for the RationalSquareMatrix class and the exact inverse and solve functions
+*/
+
+#include "catch.hpp"
+#include "rationalmatrix.h"
+
+TEST_CASE("RationalSquareMatrix constructor test", "[RationalSquareMatrix]")
+{
+    RationalSquareMatrix r{ 2, { 2, -4, 0, 6 }, -4 };
+    CHECK(r.denominator() == 2);
+    CHECK(r.numerators() == std::vector<long long>{ -1, 2, 0, -3 });
+    CHECK(r.toString() == "[[-1/2,1][0,-3/2]]");
+    CHECK(r.at(0, 1) == Fraction{ 1, 1 });
+    CHECK(RationalSquareMatrix{ 0, {}, 1 }.toString() == "[[]]");
+    CHECK_THROWS_WITH((RationalSquareMatrix{ 2, { 1 }, 1 }), "Not a square matrix");
+    CHECK_THROWS_WITH((RationalSquareMatrix{ 1, { 1 }, 0 }), "Not a square matrix");
+}
+
+TEST_CASE("Exact inverse function test", "[RationalSquareMatrix]")
+{
+    CHECK(inverse(ConcreteSquareMatrix{ "[[2,1][5,3]]" }).toString() == "[[3,-1][-5,2]]");
+    CHECK(inverse(ConcreteSquareMatrix{ "[[4,7][2,6]]" }).toString() == "[[3/5,-7/10][-1/5,2/5]]");
+    CHECK(inverse(ConcreteSquareMatrix{ "[[0,1][1,0]]" }).toString() == "[[0,1][1,0]]");
+    CHECK(inverse(ConcreteSquareMatrix{ "[[-3]]" }).toString() == "[[-1/3]]");
+    CHECK(inverse(ConcreteSquareMatrix{ "[]" }).toString() == "[[]]");
+
+    ConcreteSquareMatrix m{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    RationalSquareMatrix inv = inverse(m);
+    CHECK(inv.denominator() == 41);
+    CHECK((m * ConcreteSquareMatrix::fromValues(3, inv.numerators())) == ConcreteSquareMatrix{ "[[41,0,0][0,41,0][0,0,41]]" });
+
+    CHECK_THROWS_WITH(inverse(ConcreteSquareMatrix{ "[[1,2][2,4]]" }), "Singular matrix");
+    CHECK_THROWS_WITH(inverse(ConcreteSquareMatrix{ "[[0,0][0,0]]" }), "Singular matrix");
+    CHECK_THROWS_AS(inverse(ConcreteSquareMatrix{ "[[2000000000,0,0][0,2000000000,0][0,0,2000000000]]" }), std::overflow_error);
+}
+
+TEST_CASE("Exact solve function test", "[RationalSquareMatrix]")
+{
+    ConcreteSquareMatrix a{ "[[2,1][1,3]]" };
+    CHECK(solve(a, std::vector<long long>{ 3, 5 }) == std::vector<Fraction>{ { 4, 5 }, { 7, 5 } });
+    CHECK(solve(a, std::vector<long long>{ -3, -4 }) == std::vector<Fraction>{ { -1, 1 }, { -1, 1 } });
+    CHECK(solve(a, ConcreteSquareMatrix{ "[[2,1][1,3]]" }).toString() == "[[1,0][0,1]]");
+    CHECK_THROWS_WITH(solve(a, std::vector<long long>{ 1 }), "Incompatible matrices");
+    CHECK_THROWS_WITH(solve(a, ConcreteSquareMatrix{ "[[1]]" }), "Incompatible matrices");
+    CHECK_THROWS_WITH(solve(ConcreteSquareMatrix{ "[[1,2][2,4]]" }, std::vector<long long>{ 1, 2 }), "Singular matrix");
+
+    // The determinant of this matrix is about 10^15, so it needs two primes
+    const unsigned int n = 5;
+    std::vector<long long> vals(n * n);
+    for (unsigned int i = 0; i < n; i++)
+        for (unsigned int j = 0; j < n; j++)
+            vals[i * n + j] = (i == j) ? 1000 : static_cast<long long>(i * 7 + j * 3) % 11 - 5;
+    ConcreteSquareMatrix big = ConcreteSquareMatrix::fromValues(n, vals);
+    std::vector<long long> b(n, 1);
+    std::vector<Fraction> x = solve(big, b);
+    RationalSquareMatrix binv = inverse(big);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        // Row i of the inverse times b equals x_i
+        long long sum = 0;
+        for (unsigned int j = 0; j < n; j++)
+            sum += binv.numerators()[i * n + j];
+        long long g = std::gcd(sum, binv.denominator());
+        CHECK(x[i] == Fraction{ sum / g, binv.denominator() / g });
+    }
+}
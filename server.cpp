@@ -0,0 +1,263 @@
+/**
+    \file server.cpp
+    \brief Implementation of the CalculatorServer class
+*/
+
+#include "server.h"
+#include "calculator.h"
+#include <algorithm>
+#include <chrono>
+#include <streambuf>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace
+{
+    // Stream buffer reading from and writing to a connected socket
+    class SocketBuffer : public std::streambuf
+    {
+    public:
+        explicit SocketBuffer(int fd) : fd(fd)
+        {
+            setg(in, in, in);
+            setp(out, out + sizeof(out));
+        }
+
+        ~SocketBuffer() override { sync(); }
+
+    protected:
+        int_type underflow() override
+        {
+            ssize_t got;
+            do
+                got = ::recv(fd, in, sizeof(in), 0);
+            while (got < 0 && errno == EINTR);
+
+            if (got <= 0)
+                return traits_type::eof();
+            setg(in, in, in + got);
+            return traits_type::to_int_type(in[0]);
+        }
+
+        int_type overflow(int_type c) override
+        {
+            if (sync() != 0)
+                return traits_type::eof();
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        int sync() override
+        {
+            const char* p = pbase();
+            while (p < pptr())
+            {
+                // A client that went away must not take the server down with SIGPIPE
+                const ssize_t sent = ::send(fd, p, pptr() - p, MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR)
+                    continue;
+                if (sent <= 0)
+                {
+                    setp(out, out + sizeof(out));
+                    return -1;
+                }
+                p += sent;
+            }
+            setp(out, out + sizeof(out));
+            return 0;
+        }
+
+    private:
+        int fd;
+
+        char in[4096];
+
+        char out[4096];
+    };
+}
+
+CalculatorServer::CalculatorServer(const std::string& path, unsigned int workers) : path(path), poolSize(workers)
+{
+    sockaddr_un addr{};
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error("Cannot open the socket");
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw std::runtime_error("Cannot open the socket");
+
+    // A stale socket from an earlier run is replaced, anything else at the path is left alone
+    struct stat st;
+    if (::lstat(path.c_str(), &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+        {
+            ::close(listener);
+            throw std::runtime_error("Cannot open the socket");
+        }
+        ::unlink(path.c_str());
+    }
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listener, SOMAXCONN) < 0)
+    {
+        ::close(listener);
+        throw std::runtime_error("Cannot open the socket");
+    }
+}
+
+CalculatorServer::CalculatorServer(unsigned short port, unsigned int workers) : poolSize(workers)
+{
+    listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw std::runtime_error("Cannot open the socket");
+
+    int on = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    // Only local clients can connect
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t len = sizeof(addr);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listener, SOMAXCONN) < 0
+        || ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) < 0)
+    {
+        ::close(listener);
+        throw std::runtime_error("Cannot open the socket");
+    }
+    tcpPort = ntohs(addr.sin_port);
+}
+
+CalculatorServer::~CalculatorServer()
+{
+    stop();
+    for (auto& t : workers)
+        if (t.joinable())
+            t.join();
+
+    for (int fd : waiting)
+        ::close(fd);
+    ::close(listener);
+    if (!path.empty())
+        ::unlink(path.c_str());
+}
+
+unsigned short CalculatorServer::port() const { return tcpPort; }
+
+void CalculatorServer::serve()
+{
+    {
+        std::lock_guard<std::mutex> guard{ lock };
+        if (stopping)
+            return;
+    }
+
+    if (workers.empty())
+    {
+        unsigned int count = poolSize ? poolSize : std::thread::hardware_concurrency();
+        for (unsigned int i = 0; i < std::max(count, 1u); i++)
+            workers.emplace_back(&CalculatorServer::work, this);
+    }
+
+    while (true)
+    {
+        const int fd = ::accept(listener, nullptr, nullptr);
+        const int error = fd < 0 ? errno : 0;
+        std::unique_lock<std::mutex> guard{ lock };
+        if (stopping)
+        {
+            if (fd >= 0)
+                ::close(fd);
+            break;
+        }
+        if (fd < 0)
+        {
+            // An interrupted call or a connection gone before it was accepted is retried at once.
+            // Other errors, like running out of descriptors, persist, so wait without the lock
+            // to give the sessions a chance to end and free some.
+            if (error != EINTR && error != ECONNABORTED)
+                ready.wait_for(guard, std::chrono::milliseconds(100), [this] { return stopping; });
+            continue;
+        }
+
+        waiting.push_back(fd);
+        ready.notify_one();
+    }
+
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+}
+
+void CalculatorServer::stop()
+{
+    std::lock_guard<std::mutex> guard{ lock };
+    if (stopping)
+        return;
+    stopping = true;
+
+    // Shutting the sockets down wakes up accept and ends the sessions at their next read
+    ::shutdown(listener, SHUT_RDWR);
+    for (int fd : active)
+        ::shutdown(fd, SHUT_RD);
+    ready.notify_all();
+}
+
+void CalculatorServer::work()
+{
+    while (true)
+    {
+        int fd;
+        {
+            std::unique_lock<std::mutex> guard{ lock };
+            ready.wait(guard, [this] { return stopping || !waiting.empty(); });
+            if (stopping)
+                return;
+            fd = waiting.front();
+            waiting.pop_front();
+            active.insert(fd);
+        }
+
+        session(fd);
+
+        std::lock_guard<std::mutex> guard{ lock };
+        active.erase(fd);
+        ::close(fd);
+    }
+}
+
+void CalculatorServer::session(int fd)
+{
+    SocketBuffer buf{ fd };
+    std::istream in{ &buf };
+    std::ostream out{ &buf };
+
+    // The results are sent before the session waits for the next command
+    in.tie(&out);
+
+    Calculator calc{ out, false };
+    try
+    {
+        calc.run(in);
+    }
+    catch (const std::exception& e)
+    {
+        out << e.what() << '\n';
+    }
+    out.flush();
+}
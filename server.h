@@ -0,0 +1,98 @@
+/**
+    \file server.h
+    \brief Header for the CalculatorServer class
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+    \class CalculatorServer
+    \brief Defines a server running calculator sessions on local socket connections
+
+    Every connection is a batch session of its own with its own stack,
+    registers and variables. The results are sent back whenever the session
+    waits for more input, and the session ends with "quit" or when the
+    client closes its end. A fixed pool of workers serves the connections,
+    connections beyond the pool wait for a free worker.
+*/
+class CalculatorServer
+{
+public:
+    /**
+        \brief Parametric constructor for a Unix domain socket server
+        \param path file system path of the socket, an existing socket file is replaced
+        \param workers number of connections served at the same time, 0 for one per hardware thread
+        \exception std::runtime_error Cannot open the socket
+    */
+    CalculatorServer(const std::string& path, unsigned int workers = 0);
+
+    /**
+        \brief Parametric constructor for a TCP server on the loopback interface
+        \param port port to listen on, 0 for any free port
+        \param workers number of connections served at the same time, 0 for one per hardware thread
+        \exception std::runtime_error Cannot open the socket
+    */
+    CalculatorServer(unsigned short port, unsigned int workers = 0);
+
+    CalculatorServer(const CalculatorServer&) = delete;
+
+    CalculatorServer& operator =(const CalculatorServer&) = delete;
+
+    /**
+        \brief Destructor, stops the server
+    */
+    ~CalculatorServer();
+
+    /**
+        \brief Getter for the port the server listens on
+        \return unsigned short value of the port, 0 for a Unix domain socket
+    */
+    unsigned short port() const;
+
+    /**
+        \brief Method for accepting connections until the server is stopped
+    */
+    void serve();
+
+    /**
+        \brief Method for stopping the server, the sessions in progress are ended
+    */
+    void stop();
+
+private:
+    int listener;
+
+    std::string path;
+
+    unsigned short tcpPort = 0;
+
+    unsigned int poolSize;
+
+    std::vector<std::thread> workers;
+
+    // Accepted connections waiting for a worker
+    std::deque<int> waiting;
+
+    // Connections a worker is serving
+    std::set<int> active;
+
+    bool stopping = false;
+
+    std::mutex lock;
+
+    std::condition_variable ready;
+
+    // Serves connections until the server stops
+    void work();
+
+    // Runs one calculator session on a connection
+    static void session(int fd);
+};
@@ -0,0 +1,128 @@
+/**
+    \file server_tests.cpp
+    \brief Unit tests for the CalculatorServer class
+*/
+
+#include "catch.hpp"
+#include "server.h"
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace
+{
+    int connectTcp(unsigned short port)
+    {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        REQUIRE(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        return fd;
+    }
+
+    int connectUnix(const std::string& path)
+    {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, path.c_str());
+        REQUIRE(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        return fd;
+    }
+
+    void send(int fd, const std::string& str)
+    {
+        REQUIRE(::send(fd, str.data(), str.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(str.size()));
+    }
+
+    // Reads until the given number of lines has arrived
+    std::string receive(int fd, unsigned int lines)
+    {
+        std::string str;
+        char buf[256];
+        while (static_cast<unsigned int>(std::count(str.begin(), str.end(), '\n')) < lines)
+        {
+            const ssize_t got = ::recv(fd, buf, sizeof(buf), 0);
+            if (got <= 0)
+                break;
+            str.append(buf, got);
+        }
+        return str;
+    }
+}
+
+TEST_CASE("CalculatorServer TCP sessions test", "[CalculatorServer]")
+{
+    CalculatorServer server{ static_cast<unsigned short>(0), 2 };
+    REQUIRE(server.port() != 0);
+    std::thread t{ &CalculatorServer::serve, &server };
+
+    // Both sessions have a stack and variables of their own
+    const int a = connectTcp(server.port());
+    const int b = connectTcp(server.port());
+    send(a, "[[1,2][3,4]] x=1 [[x]]\n");
+    send(b, "[[5]] x=7 [[x]] +\n");
+    CHECK(receive(b, 1) == "[[(x+5)]]\n");
+    send(a, "+\n");
+    CHECK(receive(a, 1) == "Operation could not be executed\n");
+    send(a, "=\n");
+    CHECK(receive(a, 1) == "[[1]]\n");
+    send(b, "= foo\n");
+    CHECK(receive(b, 2) == "[[12]]\nInvalid input\n");
+
+    // "quit" ends only its own session
+    send(a, "quit\n");
+    CHECK(receive(a, 1).empty());
+    send(b, "[[2]] *\n");
+    CHECK(receive(b, 1) == "[[(2*(x+5))]]\n");
+    ::close(a);
+
+    // An error is reported and the session goes on with its stack
+    send(b, "[[y]] =\n");
+    CHECK(receive(b, 1) == "No value specified for the variable element\n");
+    send(b, "y=3 =\n");
+    CHECK(receive(b, 1) == "[[3]]\n");
+    send(b, "quit\n");
+    CHECK(receive(b, 1).empty());
+    ::close(b);
+
+    server.stop();
+    t.join();
+}
+
+TEST_CASE("CalculatorServer Unix socket test", "[CalculatorServer]")
+{
+    const std::string path = "/tmp/calculator_server_test." + std::to_string(::getpid());
+    CalculatorServer server{ path, 1 };
+    CHECK(server.port() == 0);
+    std::thread t{ &CalculatorServer::serve, &server };
+
+    const int fd = connectUnix(path);
+    send(fd, "[[1,2][3,4]] [[1,0][0,1]] *\n");
+    CHECK(receive(fd, 1) == "[[((1*1)+(0*3)),((1*2)+(0*4))][((0*1)+(1*3)),((0*2)+(1*4))]]\n");
+
+    // Stopping ends the session in progress
+    server.stop();
+    t.join();
+    CHECK(receive(fd, 1).empty());
+    ::close(fd);
+    CHECK(::access(path.c_str(), F_OK) == 0);
+
+    CHECK_THROWS_AS(CalculatorServer(std::string(200, 'x'), 1), std::runtime_error);
+
+    // A path that is not a socket is never replaced
+    const std::string file = path + ".txt";
+    ::close(::open(file.c_str(), O_CREAT | O_WRONLY, 0600));
+    CHECK_THROWS_WITH(CalculatorServer(file, 1), "Cannot open the socket");
+    CHECK(::access(file.c_str(), F_OK) == 0);
+    ::unlink(file.c_str());
+}
@@ -0,0 +1,232 @@
+/**
+    \file smallvector.h
+    \brief Header for the SmallVector class template
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+/**
+    \class SmallVector
+    \brief Defines a contiguous container that keeps up to N values inline and moves to the heap above that
+    \tparam T trivially copyable value type
+    \tparam N number of values stored inline
+*/
+template<typename T, std::size_t N> class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector requires a trivially copyable type");
+
+public:
+    /**
+        \brief Default constructor
+    */
+    SmallVector() : count(0), capacity(N) {}
+
+    /**
+        \brief Parametric constructor
+        \param size number of values
+        \param value value of every element
+    */
+    explicit SmallVector(std::size_t size, T value = T()) : SmallVector()
+    {
+        resize(size, value);
+    }
+
+    /**
+        \brief Copy constructor
+        \param v SmallVector object that is copied
+    */
+    SmallVector(const SmallVector& v) : SmallVector()
+    {
+        *this = v;
+    }
+
+    /**
+        \brief Move constructor
+        \param v SmallVector object that is moved
+    */
+    SmallVector(SmallVector&& v) noexcept : SmallVector()
+    {
+        *this = std::move(v);
+    }
+
+    /**
+        \brief Operator for assignment
+        \param v reference to a SmallVector object to assign from
+        \return Reference to the SmallVector object that has been assigned
+    */
+    SmallVector& operator =(const SmallVector& v)
+    {
+        if (this != &v)
+        {
+            count = 0;
+            reserve(v.count);
+            std::copy(v.data(), v.data() + v.count, data());
+            count = v.count;
+        }
+        return *this;
+    }
+
+    /**
+        \brief Operator for move assignment
+        \param v reference to a SmallVector object to move from, left empty
+        \return Reference to the SmallVector object that has been assigned
+    */
+    SmallVector& operator =(SmallVector&& v) noexcept
+    {
+        if (this != &v)
+        {
+            // Heap buffers change owner, inline values have to be copied
+            if (v.heap)
+            {
+                heap = std::move(v.heap);
+                capacity = v.capacity;
+            }
+            else
+            {
+                heap.reset();
+                capacity = N;
+                std::copy(v.local, v.local + v.count, local);
+            }
+            count = v.count;
+            v.count = 0;
+            v.capacity = N;
+        }
+        return *this;
+    }
+
+    /**
+        \brief Method for making room for at least size values without reallocation
+        \param size number of values
+    */
+    void reserve(std::size_t size)
+    {
+        if (size <= capacity)
+            return;
+
+        std::unique_ptr<T[]> grown(new T[size]);
+        std::copy(data(), data() + count, grown.get());
+        heap = std::move(grown);
+        capacity = size;
+    }
+
+    /**
+        \brief Method for changing the number of values
+        \param size new number of values
+        \param value value of the added elements
+    */
+    void resize(std::size_t size, T value = T())
+    {
+        reserve(size);
+        if (size > count)
+            std::fill(data() + count, data() + size, value);
+        count = size;
+    }
+
+    /**
+        \brief Method for appending a value
+        \param value value to append
+    */
+    void push_back(T value)
+    {
+        if (count == capacity)
+            reserve(std::max<std::size_t>(2 * capacity, 1));
+        data()[count++] = value;
+    }
+
+    /**
+        \brief Method for removing all values, the storage is kept
+    */
+    void clear() { count = 0; }
+
+    /**
+        \brief Getter for the number of values
+        \return size_t value of the number of values
+    */
+    std::size_t size() const { return count; }
+
+    /**
+        \brief Method for checking if the container is empty
+        \return Boolean value of the check
+    */
+    bool empty() const { return count == 0; }
+
+    /**
+        \brief Method for checking if the values are stored inline
+        \return Boolean value of the check
+    */
+    bool isInline() const { return !heap; }
+
+    /**
+        \brief Getter for the storage
+        \return pointer to the first value
+    */
+    T* data() { return heap ? heap.get() : local; }
+
+    /**
+        \brief Getter for the storage
+        \return pointer to the first value
+    */
+    const T* data() const { return heap ? heap.get() : local; }
+
+    /**
+        \brief Getter for the start of the values
+        \return pointer to the first value
+    */
+    T* begin() { return data(); }
+
+    /**
+        \brief Getter for the end of the values
+        \return pointer past the last value
+    */
+    T* end() { return data() + count; }
+
+    /**
+        \brief Getter for the start of the values
+        \return pointer to the first value
+    */
+    const T* begin() const { return data(); }
+
+    /**
+        \brief Getter for the end of the values
+        \return pointer past the last value
+    */
+    const T* end() const { return data() + count; }
+
+    /**
+        \brief Operator for accessing a value
+        \param i index of the value
+        \return reference to the value
+    */
+    T& operator [](std::size_t i) { return data()[i]; }
+
+    /**
+        \brief Operator for accessing a value
+        \param i index of the value
+        \return reference to the value
+    */
+    const T& operator [](std::size_t i) const { return data()[i]; }
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a SmallVector object to compare to
+        \return Boolean value of the comparison
+    */
+    bool operator ==(const SmallVector& rhs) const
+    {
+        return count == rhs.count && std::equal(begin(), end(), rhs.begin());
+    }
+
+private:
+    T local[N];
+
+    std::unique_ptr<T[]> heap;
+
+    std::size_t count;
+
+    std::size_t capacity;
+};
@@ -0,0 +1,52 @@
+/**
+    \file smallvector_tests.cpp
+    \brief Unit tests for the SmallVector class template
+*/
+
+#include "catch.hpp"
+#include "smallvector.h"
+
+TEST_CASE("SmallVector inline storage test", "[SmallVector]")
+{
+    SmallVector<int, 4> v;
+    CHECK(v.empty());
+    for (int i = 0; i < 4; i++)
+        v.push_back(i);
+    CHECK(v.size() == 4);
+    CHECK(v.isInline());
+    v.push_back(4);
+    CHECK_FALSE(v.isInline());
+    CHECK(v.size() == 5);
+    for (int i = 0; i < 5; i++)
+        CHECK(v[i] == i);
+}
+
+TEST_CASE("SmallVector copy and move test", "[SmallVector]")
+{
+    SmallVector<int, 4> small(3, 7);
+    SmallVector<int, 4> large(9, -1);
+
+    SmallVector<int, 4> c1{ small };
+    SmallVector<int, 4> c2{ large };
+    CHECK(c1 == small);
+    CHECK(c2 == large);
+    CHECK(c1.isInline());
+
+    SmallVector<int, 4> m1{ std::move(small) };
+    SmallVector<int, 4> m2{ std::move(large) };
+    CHECK(m1 == c1);
+    CHECK(m2 == c2);
+    CHECK(small.empty());
+    CHECK(large.empty());
+
+    m1 = m2;
+    CHECK(m1 == c2);
+    m2 = std::move(c1);
+    CHECK(m2.size() == 3);
+    CHECK(m2.isInline());
+    m2.resize(5, 2);
+    CHECK(m2[2] == 7);
+    CHECK(m2[4] == 2);
+    m2.clear();
+    CHECK(m2.empty());
+}
@@ -0,0 +1,378 @@
+/**
+    \file sparsematrix.cpp
+    \brief Implementation of the SparseSquareMatrix class
+*/
+
+#include "sparsematrix.h"
+#include "matrixkernels.h"
+#include <charconv>
+#include <climits>
+#include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+    // Values of sparse results are checked like the Widening policy of ConcreteSquareMatrix
+    int narrowed(long long v)
+    {
+        if (v < INT_MIN || v > INT_MAX)
+            throw std::overflow_error("Arithmetic overflow");
+        return static_cast<int>(v);
+    }
+}
+
+SparseSquareMatrix::SparseSquareMatrix() : n(0), rowStart(1, 0) {}
+
+SparseSquareMatrix::SparseSquareMatrix(const std::string& str_m) : SparseSquareMatrix()
+{
+    // Special cases for the empty matrix
+    if (str_m == "[]" || str_m == "[[]]")
+        return;
+
+    if (str_m.length() < 4 || str_m.front() != '[' || str_m.back() != ']')
+        throw std::invalid_argument("Not a square matrix");
+
+    // The values go straight into the compressed rows, zeros are skipped
+    const char* p = str_m.data() + 1;
+    const char* end = str_m.data() + str_m.length() - 1;
+    unsigned int rows = 0;
+    while (p < end)
+    {
+        // Each row begins with '['
+        if (*p != '[')
+            throw std::invalid_argument("Not a square matrix");
+        p++;
+
+        // Read the values of the row until ']'
+        unsigned int col = 0;
+        while (true)
+        {
+            int v;
+            auto res = std::from_chars(p, end, v);
+            if (res.ec != std::errc())
+                throw std::invalid_argument("Not a square matrix");
+            if (v != 0)
+            {
+                cols.push_back(col);
+                vals.push_back(v);
+            }
+            col++;
+            p = res.ptr;
+
+            if (p < end && *p == ',')
+                p++;
+            else if (p < end && *p == ']')
+            {
+                p++;
+                break;
+            }
+            else
+                throw std::invalid_argument("Not a square matrix");
+        }
+
+        // Every row must have the same dimension
+        if (rows == 0)
+            n = col;
+        else if (col != n)
+            throw std::invalid_argument("Not a square matrix");
+        rowStart.push_back(static_cast<unsigned int>(vals.size()));
+        rows++;
+    }
+
+    // Check that rows equal columns
+    if (rows != n)
+        throw std::invalid_argument("Not a square matrix");
+}
+
+SparseSquareMatrix::SparseSquareMatrix(const ConcreteSquareMatrix& m) : SparseSquareMatrix()
+{
+    n = m.getN();
+    std::vector<long long> dense = m.values();
+    for (unsigned int i = 0; i < n; i++)
+    {
+        for (unsigned int j = 0; j < n; j++)
+        {
+            if (dense[i * n + j] != 0)
+            {
+                cols.push_back(j);
+                vals.push_back(static_cast<int>(dense[i * n + j]));
+            }
+        }
+        rowStart.push_back(static_cast<unsigned int>(vals.size()));
+    }
+}
+
+ConcreteSquareMatrix SparseSquareMatrix::toConcrete() const
+{
+    std::vector<long long> dense(static_cast<std::size_t>(n) * n, 0);
+    for (unsigned int i = 0; i < n; i++)
+        for (unsigned int p = rowStart[i]; p < rowStart[i + 1]; p++)
+            dense[i * n + cols[p]] = vals[p];
+
+    return ConcreteSquareMatrix::fromValues(n, dense);
+}
+
+std::string SparseSquareMatrix::toString() const
+{
+    // Initialize the string
+    std::string str = "[";
+
+    // Empty matrix case
+    if (n == 0)
+        str.append("[]]");
+
+    else
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            str.push_back('[');
+            unsigned int p = rowStart[i];
+            for (unsigned int j = 0; j < n; j++)
+            {
+                // The stored columns of a row are sorted, so one cursor walks them
+                if (p < rowStart[i + 1] && cols[p] == j)
+                    str.append(std::to_string(vals[p++]));
+                else
+                    str.push_back('0');
+                str.push_back(',');
+            }
+
+            // Remove last ',' and close the row
+            str.pop_back();
+            str.push_back(']');
+        }
+        // Close the matrix
+        str.push_back(']');
+    }
+
+    return str;
+}
+
+unsigned int SparseSquareMatrix::getN() const { return n; }
+
+std::size_t SparseSquareMatrix::nonZeros() const { return vals.size(); }
+
+int SparseSquareMatrix::at(unsigned int i, unsigned int j) const
+{
+    auto first = cols.begin() + rowStart[i];
+    auto last = cols.begin() + rowStart[i + 1];
+    auto it = std::lower_bound(first, last, j);
+    return (it != last && *it == j) ? vals[it - cols.begin()] : 0;
+}
+
+SparseSquareMatrix SparseSquareMatrix::transpose() const
+{
+    SparseSquareMatrix t;
+    t.n = n;
+    t.rowStart.assign(n + 1, 0);
+    t.cols.resize(vals.size());
+    t.vals.resize(vals.size());
+
+    // Count the values of each column, then turn the counts into offsets
+    for (unsigned int c : cols)
+        t.rowStart[c + 1]++;
+    for (unsigned int j = 0; j < n; j++)
+        t.rowStart[j + 1] += t.rowStart[j];
+
+    // Walking the rows in order keeps the new rows sorted
+    std::vector<unsigned int> next(t.rowStart.begin(), t.rowStart.end() - 1);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        for (unsigned int p = rowStart[i]; p < rowStart[i + 1]; p++)
+        {
+            unsigned int q = next[cols[p]]++;
+            t.cols[q] = i;
+            t.vals[q] = vals[p];
+        }
+    }
+
+    return t;
+}
+
+std::vector<long long> SparseSquareMatrix::multiply(const std::vector<long long>& x) const
+{
+    // Check dimensions
+    if (x.size() != n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    std::vector<long long> y(n, 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        long long sum = 0;
+        for (unsigned int p = rowStart[i]; p < rowStart[i + 1]; p++)
+            checkedMultiplyAdd(sum, vals[p], x[cols[p]]);
+        y[i] = sum;
+    }
+
+    return y;
+}
+
+bool SparseSquareMatrix::operator ==(const SparseSquareMatrix& rhs) const
+{
+    return n == rhs.n && rowStart == rhs.rowStart && cols == rhs.cols && vals == rhs.vals;
+}
+
+SparseSquareMatrix SparseSquareMatrix::combine(const SparseSquareMatrix& rhs, int sign) const
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    SparseSquareMatrix res;
+    res.n = n;
+    res.cols.reserve(vals.size() + rhs.vals.size());
+    res.vals.reserve(vals.size() + rhs.vals.size());
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        // Merge the two sorted rows, values that cancel out are not stored
+        unsigned int p = rowStart[i];
+        unsigned int q = rhs.rowStart[i];
+        while (p < rowStart[i + 1] || q < rhs.rowStart[i + 1])
+        {
+            unsigned int col;
+            long long v;
+            if (q == rhs.rowStart[i + 1] || (p < rowStart[i + 1] && cols[p] < rhs.cols[q]))
+            {
+                col = cols[p];
+                v = vals[p++];
+            }
+            else if (p == rowStart[i + 1] || rhs.cols[q] < cols[p])
+            {
+                col = rhs.cols[q];
+                v = sign * static_cast<long long>(rhs.vals[q++]);
+            }
+            else
+            {
+                col = cols[p];
+                v = vals[p++] + sign * static_cast<long long>(rhs.vals[q++]);
+            }
+
+            if (v != 0)
+            {
+                res.cols.push_back(col);
+                res.vals.push_back(narrowed(v));
+            }
+        }
+        res.rowStart.push_back(static_cast<unsigned int>(res.vals.size()));
+    }
+
+    return res;
+}
+
+SparseSquareMatrix SparseSquareMatrix::operator +(const SparseSquareMatrix& rhs) const
+{
+    return combine(rhs, 1);
+}
+
+SparseSquareMatrix SparseSquareMatrix::operator -(const SparseSquareMatrix& rhs) const
+{
+    return combine(rhs, -1);
+}
+
+SparseSquareMatrix SparseSquareMatrix::operator *(const SparseSquareMatrix& rhs) const
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    SparseSquareMatrix res;
+    res.n = n;
+
+    // Gustavson's algorithm: row i of the product is a sum of the rows of rhs
+    // picked by the nonzeros of row i. The dense accumulator is reused and
+    // only the touched columns are visited and cleared.
+    std::vector<long long> acc(n, 0);
+    std::vector<unsigned int> mark(n, UINT_MAX);
+    std::vector<unsigned int> touched;
+    for (unsigned int i = 0; i < n; i++)
+    {
+        touched.clear();
+        for (unsigned int p = rowStart[i]; p < rowStart[i + 1]; p++)
+        {
+            const long long a = vals[p];
+            const unsigned int k = cols[p];
+            for (unsigned int q = rhs.rowStart[k]; q < rhs.rowStart[k + 1]; q++)
+            {
+                const unsigned int j = rhs.cols[q];
+                if (mark[j] != i)
+                {
+                    mark[j] = i;
+                    acc[j] = 0;
+                    touched.push_back(j);
+                }
+                checkedMultiplyAdd(acc[j], a, rhs.vals[q]);
+            }
+        }
+
+        std::sort(touched.begin(), touched.end());
+        for (unsigned int j : touched)
+        {
+            if (acc[j] != 0)
+            {
+                res.cols.push_back(j);
+                res.vals.push_back(narrowed(acc[j]));
+            }
+        }
+        res.rowStart.push_back(static_cast<unsigned int>(res.vals.size()));
+    }
+
+    return res;
+}
+
+ConcreteSquareMatrix SparseSquareMatrix::operator *(const ConcreteSquareMatrix& rhs) const
+{
+    // Check dimensions
+    if (n != rhs.getN())
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Row i of the product collects the rows of rhs picked by row i
+    std::vector<long long> b = rhs.values();
+    std::vector<long long> c(b.size(), 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        long long* cRow = c.data() + static_cast<std::size_t>(i) * n;
+        for (unsigned int p = rowStart[i]; p < rowStart[i + 1]; p++)
+        {
+            const long long* bRow = b.data() + static_cast<std::size_t>(cols[p]) * n;
+            if (checkedAxpyKernel(cRow, bRow, vals[p], n))
+                throw std::overflow_error("Arithmetic overflow");
+        }
+    }
+    narrowKernel(c.data(), c.size(), ArithmeticPolicy::Widening);
+
+    return ConcreteSquareMatrix::fromValues(n, c);
+}
+
+ConcreteSquareMatrix operator *(const ConcreteSquareMatrix& lhs, const SparseSquareMatrix& rhs)
+{
+    // Check dimensions
+    const unsigned int n = rhs.n;
+    if (lhs.getN() != n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Each value of lhs scales one sparse row of rhs into the result row
+    std::vector<long long> a = lhs.values();
+    std::vector<long long> c(a.size(), 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        long long* cRow = c.data() + static_cast<std::size_t>(i) * n;
+        for (unsigned int k = 0; k < n; k++)
+        {
+            const long long aik = a[static_cast<std::size_t>(i) * n + k];
+            if (aik == 0)
+                continue;
+            for (unsigned int q = rhs.rowStart[k]; q < rhs.rowStart[k + 1]; q++)
+                checkedMultiplyAdd(cRow[rhs.cols[q]], aik, rhs.vals[q]);
+        }
+    }
+    narrowKernel(c.data(), c.size(), ArithmeticPolicy::Widening);
+
+    return ConcreteSquareMatrix::fromValues(n, c);
+}
+
+std::ostream& operator <<(std::ostream& os, const SparseSquareMatrix& m)
+{
+    os << m.toString();
+    return os;
+}
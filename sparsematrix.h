@@ -0,0 +1,163 @@
+/**
+    \file sparsematrix.h
+    \brief Header for the SparseSquareMatrix class
+*/
+
+#pragma once
+
+#include "elementarymatrix.h"
+#include <vector>
+#include <string>
+#include <ostream>
+
+/**
+    \class SparseSquareMatrix
+    \brief Defines a class for an integer matrix that stores only its nonzero values
+
+    The values are kept in compressed sparse row (CSR) form: rowStart holds
+    n + 1 offsets into the column indices and values of each row, and the
+    columns of a row are sorted. The CSR form of the transpose is the
+    compressed sparse column (CSC) form of the matrix, so transpose() is
+    also the conversion between the two. Memory and the cost of every
+    operation scale with the number of nonzeros.
+*/
+class SparseSquareMatrix
+{
+public:
+    /**
+        \brief Default constructor
+    */
+    SparseSquareMatrix();
+
+    /**
+        \brief Parametric constructor, zeros in the string are not stored
+        \param str_m String representation of the matrix
+        \exception std::invalid_argument Not a square matrix
+    */
+    SparseSquareMatrix(const std::string& str_m);
+
+    /**
+        \brief Parametric constructor
+        \param m reference to a ConcreteSquareMatrix object whose nonzero values are stored
+    */
+    explicit SparseSquareMatrix(const ConcreteSquareMatrix& m);
+
+    /**
+        \brief Method for converting the matrix into a ConcreteSquareMatrix
+        \return ConcreteSquareMatrix object holding the values
+    */
+    ConcreteSquareMatrix toConcrete() const;
+
+    /**
+        \brief Method for creating a string representation of the matrix
+        \return string that is the string representation of the matrix
+    */
+    std::string toString() const;
+
+    /**
+        \brief Getter for the size n of the matrix
+        \return unsigned int value of the attribute n
+    */
+    unsigned int getN() const;
+
+    /**
+        \brief Getter for the number of stored values
+        \return size_t value of the number of nonzeros
+    */
+    std::size_t nonZeros() const;
+
+    /**
+        \brief Getter for a value of the matrix
+        \param i row index
+        \param j column index
+        \return int value at row i and column j
+    */
+    int at(unsigned int i, unsigned int j) const;
+
+    /**
+        \brief Method for creating a new matrix that is a transpose of the matrix
+        \return SparseSquareMatrix object that is the transpose of the matrix
+    */
+    SparseSquareMatrix transpose() const;
+
+    /**
+        \brief Method for multiplying the matrix with a vector (SpMV)
+        \param x reference to a vector of n values
+        \return vector of the n values of the product
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    std::vector<long long> multiply(const std::vector<long long>& x) const;
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a SparseSquareMatrix object to compare to
+        \return Boolean value of the comparison
+    */
+    bool operator ==(const SparseSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a SparseSquareMatrix object that is the right hand side of the addition
+        \return SparseSquareMatrix object that is the result of the addition
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    SparseSquareMatrix operator +(const SparseSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a SparseSquareMatrix object that is the right hand side of the subtraction
+        \return SparseSquareMatrix object that is the result of the subtraction
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    SparseSquareMatrix operator -(const SparseSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for multiplication of two sparse matrices (SpGEMM)
+        \param rhs reference to a SparseSquareMatrix object that is the right hand side of the multiplication
+        \return SparseSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    SparseSquareMatrix operator *(const SparseSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for multiplication of the sparse matrix with a dense matrix (SpMM)
+        \param rhs reference to a ConcreteSquareMatrix object that is the right hand side of the multiplication
+        \return ConcreteSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    ConcreteSquareMatrix operator *(const ConcreteSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for multiplication of a dense matrix with a sparse matrix
+        \param lhs reference to a ConcreteSquareMatrix object that is the left hand side of the multiplication
+        \param rhs reference to a SparseSquareMatrix object that is the right hand side of the multiplication
+        \return ConcreteSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    friend ConcreteSquareMatrix operator *(const ConcreteSquareMatrix& lhs, const SparseSquareMatrix& rhs);
+
+private:
+    unsigned int n;
+
+    std::vector<unsigned int> rowStart;
+
+    std::vector<unsigned int> cols;
+
+    std::vector<int> vals;
+
+    // Merges the rows of two matrices, sign is +1 for addition and -1 for subtraction
+    SparseSquareMatrix combine(const SparseSquareMatrix& rhs, int sign) const;
+};
+
+/**
+    \brief Operator for output
+    \param os stream to print in
+    \param m reference to a SparseSquareMatrix object
+*/
+std::ostream& operator <<(std::ostream& os, const SparseSquareMatrix& m);
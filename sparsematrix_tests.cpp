@@ -0,0 +1,86 @@
+/**
+    \file sparsematrix_tests.cpp
+    \brief Unit tests for the SparseSquareMatrix class
+*/
+
+#include "catch.hpp"
+#include "sparsematrix.h"
+
+TEST_CASE("SparseSquareMatrix parametric constructor test", "[SparseSquareMatrix]")
+{
+    SparseSquareMatrix s{ "[[0,0,3][0,0,0][-7,0,1]]" };
+    CHECK(s.getN() == 3);
+    CHECK(s.nonZeros() == 3);
+    CHECK(s.at(0, 2) == 3);
+    CHECK(s.at(1, 1) == 0);
+    CHECK(s.at(2, 0) == -7);
+    CHECK(s.toString() == "[[0,0,3][0,0,0][-7,0,1]]");
+    CHECK(s.toConcrete() == ConcreteSquareMatrix{ "[[0,0,3][0,0,0][-7,0,1]]" });
+    CHECK(SparseSquareMatrix{ ConcreteSquareMatrix{ "[[0,0,3][0,0,0][-7,0,1]]" } } == s);
+    CHECK(SparseSquareMatrix{ "[]" }.toString() == "[[]]");
+    CHECK(SparseSquareMatrix{ "[[0]]" }.nonZeros() == 0);
+    CHECK_THROWS_WITH(SparseSquareMatrix{ "[[1,2][3]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(SparseSquareMatrix{ "[[1,2][3,4][5,6]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(SparseSquareMatrix{ "[[x]]" }, "Not a square matrix");
+    CHECK_THROWS_WITH(SparseSquareMatrix{ "[[3000000000]]" }, "Not a square matrix");
+}
+
+TEST_CASE("SparseSquareMatrix arithmetic operator test", "[SparseSquareMatrix]")
+{
+    ConcreteSquareMatrix m1{ "[[3,0,4][0,-2,0][6,0,0]]" };
+    ConcreteSquareMatrix m2{ "[[-5,0,0][1,2,3][0,-7,0]]" };
+    SparseSquareMatrix s1{ m1 };
+    SparseSquareMatrix s2{ m2 };
+    CHECK((s1 + s2).toConcrete() == m1 + m2);
+    CHECK((s1 - s2).toConcrete() == m1 - m2);
+    CHECK((s1 - s1).nonZeros() == 0);
+    CHECK((s1 * s2).toConcrete() == m1 * m2);
+    CHECK(s1 * m2 == m1 * m2);
+    CHECK(m1 * s2 == m1 * m2);
+    CHECK(s1.transpose().toConcrete() == m1.transpose());
+    CHECK(s1.transpose().transpose() == s1);
+    CHECK(s1.multiply({ 1, 2, 3 }) == std::vector<long long>{ 15, -4, 6 });
+
+    CHECK_THROWS_WITH(s1 * SparseSquareMatrix{ "[[1]]" }, "Incompatible matrices");
+    CHECK_THROWS_WITH(s1 + SparseSquareMatrix{ "[[1]]" }, "Incompatible matrices");
+    CHECK_THROWS_WITH(s1 * ConcreteSquareMatrix{ "[[1]]" }, "Incompatible matrices");
+    CHECK_THROWS_WITH(s1.multiply({ 1 }), "Incompatible matrices");
+
+    SparseSquareMatrix big{ "[[2147483647,0][0,1]]" };
+    CHECK_THROWS_AS(big + big, std::overflow_error);
+    CHECK_THROWS_AS(big * big, std::overflow_error);
+
+    // 4 * 2^62 overflows the 64-bit accumulator itself
+    ConcreteSquareMatrix min4 = ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, INT_MIN));
+    SparseSquareMatrix smin4{ min4 };
+    CHECK_THROWS_WITH(smin4 * smin4, "Arithmetic overflow");
+    CHECK_THROWS_WITH(smin4 * min4, "Arithmetic overflow");
+    CHECK_THROWS_WITH(min4 * smin4, "Arithmetic overflow");
+    CHECK_THROWS_WITH(SparseSquareMatrix{ "[[2,0][0,1]]" }.multiply({ LLONG_MAX, 1 }), "Arithmetic overflow");
+}
+
+TEST_CASE("SparseSquareMatrix large diagonal test", "[SparseSquareMatrix]")
+{
+    // A 1000 x 1000 band stores about 3000 values instead of a million
+    std::string str = "[";
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        str += "[";
+        for (unsigned int j = 0; j < 1000; j++)
+        {
+            int v = (i == j) ? 2 : ((i == j + 1 || j == i + 1) ? -1 : 0);
+            str += std::to_string(v) + (j + 1 < 1000 ? "," : "");
+        }
+        str += "]";
+    }
+    str += "]";
+
+    SparseSquareMatrix s{ str };
+    CHECK(s.nonZeros() == 2998);
+    SparseSquareMatrix s2 = s * s;
+    CHECK(s2.nonZeros() == 4994);
+    CHECK(s2.at(500, 500) == 6);
+    CHECK(s2.at(500, 502) == 1);
+    CHECK(s2.at(0, 0) == 5);
+    CHECK(s2.toConcrete() == s.toConcrete() * s.toConcrete());
+}
@@ -0,0 +1,259 @@
+/**
+    \file structuredmatrix.cpp
+    \brief Implementation of the StructuredSquareMatrix class
+*/
+
+#include "structuredmatrix.h"
+#include "numericmatrix.h"
+#include "matrixkernels.h"
+#include <algorithm>
+#include <stdexcept>
+
+StructuredSquareMatrix::StructuredSquareMatrix() : n(0), lower(0), upper(0), unit(false), rowStart(1, 0) {}
+
+StructuredSquareMatrix::StructuredSquareMatrix(const std::string& str_m) : StructuredSquareMatrix()
+{
+    unsigned int size;
+    std::vector<int> parsed;
+    if (!parseNumericSquareMatrix(str_m, size, parsed))
+        throw std::invalid_argument("Not a square matrix");
+
+    fromDense(size, std::vector<long long>(parsed.begin(), parsed.end()));
+}
+
+StructuredSquareMatrix::StructuredSquareMatrix(const ConcreteSquareMatrix& m) : StructuredSquareMatrix()
+{
+    fromDense(m.getN(), m.values());
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::identity(unsigned int size)
+{
+    StructuredSquareMatrix m;
+    m.shape(size, 0, 0);
+    m.unit = size > 0;
+    m.vals.clear();
+    return m;
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::diagonal(const std::vector<int>& d)
+{
+    StructuredSquareMatrix m;
+    m.shape(static_cast<unsigned int>(d.size()), 0, 0);
+    m.vals = d;
+    return m;
+}
+
+void StructuredSquareMatrix::shape(unsigned int size, unsigned int lo, unsigned int up)
+{
+    n = size;
+    lower = n ? std::min(lo, n - 1) : 0;
+    upper = n ? std::min(up, n - 1) : 0;
+    unit = false;
+
+    rowStart.assign(n + 1, 0);
+    for (unsigned int i = 0; i < n; i++)
+        rowStart[i + 1] = rowStart[i] + (last(i) - first(i) + 1);
+    vals.assign(rowStart[n], 0);
+}
+
+void StructuredSquareMatrix::fromDense(unsigned int size, const std::vector<long long>& dense)
+{
+    // The bandwidths are the furthest nonzeros from the diagonal
+    unsigned int lo = 0;
+    unsigned int up = 0;
+    bool ones = size > 0;
+    for (unsigned int i = 0; i < size; i++)
+    {
+        for (unsigned int j = 0; j < size; j++)
+        {
+            const long long v = dense[static_cast<std::size_t>(i) * size + j];
+            if (i == j && v != 1)
+                ones = false;
+            if (v == 0)
+                continue;
+            if (i > j)
+                lo = std::max(lo, i - j);
+            else
+                up = std::max(up, j - i);
+        }
+    }
+
+    shape(size, lo, up);
+    if (ones && lower == 0 && upper == 0)
+    {
+        unit = true;
+        vals.clear();
+        return;
+    }
+
+    for (unsigned int i = 0; i < n; i++)
+        for (unsigned int j = first(i); j <= last(i); j++)
+            vals[rowStart[i] + j - first(i)] = static_cast<int>(dense[static_cast<std::size_t>(i) * n + j]);
+}
+
+ConcreteSquareMatrix StructuredSquareMatrix::toConcrete() const
+{
+    std::vector<long long> dense(static_cast<std::size_t>(n) * n, 0);
+    for (unsigned int i = 0; i < n; i++)
+        for (unsigned int j = first(i); j <= last(i); j++)
+            dense[static_cast<std::size_t>(i) * n + j] = at(i, j);
+
+    return ConcreteSquareMatrix::fromValues(n, dense);
+}
+
+std::string StructuredSquareMatrix::toString() const
+{
+    return toConcrete().toString();
+}
+
+unsigned int StructuredSquareMatrix::getN() const { return n; }
+
+MatrixStructure StructuredSquareMatrix::structure() const
+{
+    if (unit)
+        return MatrixStructure::Identity;
+    if (lower == 0 && upper == 0)
+        return MatrixStructure::Diagonal;
+    if (lower == 0)
+        return MatrixStructure::UpperTriangular;
+    if (upper == 0)
+        return MatrixStructure::LowerTriangular;
+    if (lower == n - 1 && upper == n - 1)
+        return MatrixStructure::General;
+    return MatrixStructure::Banded;
+}
+
+unsigned int StructuredSquareMatrix::lowerBandwidth() const { return lower; }
+
+unsigned int StructuredSquareMatrix::upperBandwidth() const { return upper; }
+
+std::size_t StructuredSquareMatrix::storedValues() const { return vals.size(); }
+
+int StructuredSquareMatrix::at(unsigned int i, unsigned int j) const
+{
+    if (unit)
+        return i == j ? 1 : 0;
+    if (j < first(i) || j > last(i))
+        return 0;
+    return vals[rowStart[i] + j - first(i)];
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::transpose() const
+{
+    if (unit || (lower == 0 && upper == 0))
+        return *this;
+
+    StructuredSquareMatrix t;
+    t.shape(n, upper, lower);
+    for (unsigned int i = 0; i < n; i++)
+        for (unsigned int j = first(i); j <= last(i); j++)
+            t.vals[t.rowStart[j] + i - t.first(j)] = vals[rowStart[i] + j - first(i)];
+
+    return t;
+}
+
+bool StructuredSquareMatrix::operator ==(const StructuredSquareMatrix& rhs) const
+{
+    if (n != rhs.n)
+        return false;
+
+    // Outside the union of the two bands both matrices are zero
+    for (unsigned int i = 0; i < n; i++)
+    {
+        const unsigned int hi = std::max(last(i), rhs.last(i));
+        for (unsigned int j = std::min(first(i), rhs.first(i)); j <= hi; j++)
+            if (at(i, j) != rhs.at(i, j))
+                return false;
+    }
+
+    return true;
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::combine(const StructuredSquareMatrix& rhs, int sign) const
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    StructuredSquareMatrix res;
+    res.shape(n, std::max(lower, rhs.lower), std::max(upper, rhs.upper));
+
+    // Only the band of each operand is visited
+    std::vector<long long> acc(res.vals.size(), 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        long long* row = acc.data() + res.rowStart[i] - res.first(i);
+        for (unsigned int j = first(i); j <= last(i); j++)
+            row[j] += at(i, j);
+        for (unsigned int j = rhs.first(i); j <= rhs.last(i); j++)
+            row[j] += sign * static_cast<long long>(rhs.at(i, j));
+    }
+    narrowKernel(acc.data(), acc.size(), ArithmeticPolicy::Widening);
+    res.vals.assign(acc.begin(), acc.end());
+
+    return res;
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::operator +(const StructuredSquareMatrix& rhs) const
+{
+    return combine(rhs, 1);
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::operator -(const StructuredSquareMatrix& rhs) const
+{
+    return combine(rhs, -1);
+}
+
+StructuredSquareMatrix StructuredSquareMatrix::operator *(const StructuredSquareMatrix& rhs) const
+{
+    // Check dimensions
+    if (n != rhs.n)
+        throw std::invalid_argument("Incompatible matrices");
+
+    // Multiplying by the identity costs nothing
+    if (unit)
+        return rhs;
+    if (rhs.unit)
+        return *this;
+
+    // The bandwidths of the product are the sums of the bandwidths
+    StructuredSquareMatrix res;
+    res.shape(n, lower + rhs.lower, upper + rhs.upper);
+
+    std::vector<long long> acc(res.vals.size(), 0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+        long long* row = acc.data() + res.rowStart[i] - res.first(i);
+        for (unsigned int k = first(i); k <= last(i); k++)
+        {
+            const long long a = vals[rowStart[i] + k - first(i)];
+            if (a == 0)
+                continue;
+            const int* bRow = rhs.vals.data() + rhs.rowStart[k] - rhs.first(k);
+            const unsigned int j0 = rhs.first(k);
+            if (checkedAxpyKernel(row + j0, bRow + j0, a, rhs.last(k) - j0 + 1))
+                throw std::overflow_error("Arithmetic overflow");
+        }
+    }
+    narrowKernel(acc.data(), acc.size(), ArithmeticPolicy::Widening);
+    res.vals.assign(acc.begin(), acc.end());
+
+    return res;
+}
+
+ConcreteSquareMatrix operator *(const StructuredSquareMatrix& lhs, const ConcreteSquareMatrix& rhs)
+{
+    // The dense operand gets its structure detected too
+    return (lhs * StructuredSquareMatrix{ rhs }).toConcrete();
+}
+
+ConcreteSquareMatrix operator *(const ConcreteSquareMatrix& lhs, const StructuredSquareMatrix& rhs)
+{
+    return (StructuredSquareMatrix{ lhs } * rhs).toConcrete();
+}
+
+std::ostream& operator <<(std::ostream& os, const StructuredSquareMatrix& m)
+{
+    os << m.toString();
+    return os;
+}
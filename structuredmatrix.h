@@ -0,0 +1,215 @@
+/**
+    \file structuredmatrix.h
+    \brief Header for the StructuredSquareMatrix class
+*/
+
+#pragma once
+
+#include "elementarymatrix.h"
+#include <vector>
+#include <string>
+#include <ostream>
+
+/**
+    \brief Structure of the nonzero values of a matrix
+*/
+enum class MatrixStructure
+{
+    General,            ///< Values anywhere
+    Banded,             ///< Values within a band around the diagonal
+    UpperTriangular,    ///< Values on and above the diagonal
+    LowerTriangular,    ///< Values on and below the diagonal
+    Diagonal,           ///< Values only on the diagonal
+    Identity            ///< Ones on the diagonal, nothing is stored
+};
+
+/**
+    \class StructuredSquareMatrix
+    \brief Defines a class for an integer matrix that stores only the band holding its nonzero values
+
+    Row i stores the columns i - lower ... i + upper, clipped to the matrix,
+    so a diagonal matrix stores n values, a triangular one n(n + 1) / 2 and
+    a banded one about n(lower + upper + 1). The structure is detected from
+    the values when the matrix is parsed or converted. Addition and
+    subtraction cost O(n * bandwidth) and the product of bandwidths b1 and
+    b2 costs O(n * b1 * b2), so scaling by a diagonal matrix is O(n^2).
+*/
+class StructuredSquareMatrix
+{
+public:
+    /**
+        \brief Default constructor
+    */
+    StructuredSquareMatrix();
+
+    /**
+        \brief Parametric constructor, the structure is detected from the values
+        \param str_m String representation of the matrix
+        \exception std::invalid_argument Not a square matrix
+    */
+    StructuredSquareMatrix(const std::string& str_m);
+
+    /**
+        \brief Parametric constructor, the structure is detected from the values
+        \param m reference to a ConcreteSquareMatrix object
+    */
+    explicit StructuredSquareMatrix(const ConcreteSquareMatrix& m);
+
+    /**
+        \brief Method for creating the identity matrix
+        \param size size n of the matrix
+        \return StructuredSquareMatrix object that is the identity matrix
+    */
+    static StructuredSquareMatrix identity(unsigned int size);
+
+    /**
+        \brief Method for creating a diagonal matrix
+        \param d vector of the values on the diagonal
+        \return StructuredSquareMatrix object with d on the diagonal
+    */
+    static StructuredSquareMatrix diagonal(const std::vector<int>& d);
+
+    /**
+        \brief Method for converting the matrix into a ConcreteSquareMatrix
+        \return ConcreteSquareMatrix object holding the values
+    */
+    ConcreteSquareMatrix toConcrete() const;
+
+    /**
+        \brief Method for creating a string representation of the matrix
+        \return string that is the string representation of the matrix
+    */
+    std::string toString() const;
+
+    /**
+        \brief Getter for the size n of the matrix
+        \return unsigned int value of the attribute n
+    */
+    unsigned int getN() const;
+
+    /**
+        \brief Getter for the structure of the matrix
+        \return MatrixStructure value
+    */
+    MatrixStructure structure() const;
+
+    /**
+        \brief Getter for the number of stored diagonals below the main diagonal
+        \return unsigned int value of the lower bandwidth
+    */
+    unsigned int lowerBandwidth() const;
+
+    /**
+        \brief Getter for the number of stored diagonals above the main diagonal
+        \return unsigned int value of the upper bandwidth
+    */
+    unsigned int upperBandwidth() const;
+
+    /**
+        \brief Getter for the number of stored values
+        \return size_t value of the number of stored values
+    */
+    std::size_t storedValues() const;
+
+    /**
+        \brief Getter for a value of the matrix
+        \param i row index
+        \param j column index
+        \return int value at row i and column j
+    */
+    int at(unsigned int i, unsigned int j) const;
+
+    /**
+        \brief Method for creating a new matrix that is a transpose of the matrix
+        \return StructuredSquareMatrix object that is the transpose of the matrix
+    */
+    StructuredSquareMatrix transpose() const;
+
+    /**
+        \brief Operator for comparison
+        \param rhs reference to a StructuredSquareMatrix object to compare to
+        \return Boolean value of the comparison of the values, the stored band does not matter
+    */
+    bool operator ==(const StructuredSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for addition
+        \param rhs reference to a StructuredSquareMatrix object that is the right hand side of the addition
+        \return StructuredSquareMatrix object that is the result of the addition
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    StructuredSquareMatrix operator +(const StructuredSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for subtraction
+        \param rhs reference to a StructuredSquareMatrix object that is the right hand side of the subtraction
+        \return StructuredSquareMatrix object that is the result of the subtraction
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    StructuredSquareMatrix operator -(const StructuredSquareMatrix& rhs) const;
+
+    /**
+        \brief Operator for multiplication
+        \param rhs reference to a StructuredSquareMatrix object that is the right hand side of the multiplication
+        \return StructuredSquareMatrix object that is the result of the multiplication
+        \exception std::invalid_argument Incompatible matrices
+        \exception std::overflow_error Arithmetic overflow
+    */
+    StructuredSquareMatrix operator *(const StructuredSquareMatrix& rhs) const;
+
+private:
+    unsigned int n;
+
+    unsigned int lower;
+
+    unsigned int upper;
+
+    bool unit;
+
+    // Offsets of the rows in vals, n + 1 values
+    std::vector<std::size_t> rowStart;
+
+    std::vector<int> vals;
+
+    // Sets the size and the band and zeroes the stored values
+    void shape(unsigned int size, unsigned int lo, unsigned int up);
+
+    // First and last stored column of row i
+    unsigned int first(unsigned int i) const { return i > lower ? i - lower : 0; }
+    unsigned int last(unsigned int i) const { return (n - 1 - i > upper) ? i + upper : n - 1; }
+
+    // Builds the band of the row-major values, detecting the bandwidths
+    void fromDense(unsigned int size, const std::vector<long long>& dense);
+
+    // Narrows the band values of a result, sign is +1 for addition and -1 for subtraction
+    StructuredSquareMatrix combine(const StructuredSquareMatrix& rhs, int sign) const;
+};
+
+/**
+    \brief Operator for multiplication of a structured matrix with a dense matrix
+    \param lhs reference to a StructuredSquareMatrix object that is the left hand side of the multiplication
+    \param rhs reference to a ConcreteSquareMatrix object that is the right hand side of the multiplication
+    \return ConcreteSquareMatrix object that is the result of the multiplication
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::overflow_error Arithmetic overflow
+*/
+ConcreteSquareMatrix operator *(const StructuredSquareMatrix& lhs, const ConcreteSquareMatrix& rhs);
+
+/**
+    \brief Operator for multiplication of a dense matrix with a structured matrix
+    \param lhs reference to a ConcreteSquareMatrix object that is the left hand side of the multiplication
+    \param rhs reference to a StructuredSquareMatrix object that is the right hand side of the multiplication
+    \return ConcreteSquareMatrix object that is the result of the multiplication
+    \exception std::invalid_argument Incompatible matrices
+    \exception std::overflow_error Arithmetic overflow
+*/
+ConcreteSquareMatrix operator *(const ConcreteSquareMatrix& lhs, const StructuredSquareMatrix& rhs);
+
+/**
+    \brief Operator for output
+    \param os stream to print in
+    \param m reference to a StructuredSquareMatrix object
+*/
+std::ostream& operator <<(std::ostream& os, const StructuredSquareMatrix& m);
@@ -0,0 +1,84 @@
+/**
+    \file structuredmatrix_tests.cpp
+    \brief Unit tests for the StructuredSquareMatrix class
+*/
+
+#include "catch.hpp"
+#include "structuredmatrix.h"
+
+TEST_CASE("StructuredSquareMatrix structure detection test", "[StructuredSquareMatrix]")
+{
+    CHECK(StructuredSquareMatrix{ "[[1,0,0][0,1,0][0,0,1]]" }.structure() == MatrixStructure::Identity);
+    CHECK(StructuredSquareMatrix{ "[[1,0,0][0,1,0][0,0,1]]" }.storedValues() == 0);
+    CHECK(StructuredSquareMatrix{ "[[2,0,0][0,-1,0][0,0,5]]" }.structure() == MatrixStructure::Diagonal);
+    CHECK(StructuredSquareMatrix{ "[[2,0,0][0,-1,0][0,0,5]]" }.storedValues() == 3);
+    CHECK(StructuredSquareMatrix{ "[[2,1,3][0,-1,4][0,0,5]]" }.structure() == MatrixStructure::UpperTriangular);
+    CHECK(StructuredSquareMatrix{ "[[2,1,3][0,-1,4][0,0,5]]" }.storedValues() == 6);
+    CHECK(StructuredSquareMatrix{ "[[2,0,0][1,-1,0][3,4,5]]" }.structure() == MatrixStructure::LowerTriangular);
+    CHECK(StructuredSquareMatrix{ "[[2,1,0,0][1,2,1,0][0,1,2,1][0,0,1,2]]" }.structure() == MatrixStructure::Banded);
+    CHECK(StructuredSquareMatrix{ "[[2,1,0,0][1,2,1,0][0,1,2,1][0,0,1,2]]" }.storedValues() == 10);
+    CHECK(StructuredSquareMatrix{ "[[2,0,1][0,0,0][1,0,0]]" }.structure() == MatrixStructure::General);
+
+    StructuredSquareMatrix b{ "[[2,1,0,0][1,2,1,0][0,1,2,1][0,0,1,2]]" };
+    CHECK(b.lowerBandwidth() == 1);
+    CHECK(b.upperBandwidth() == 1);
+    CHECK(b.at(2, 1) == 1);
+    CHECK(b.at(3, 0) == 0);
+    CHECK(b.toString() == "[[2,1,0,0][1,2,1,0][0,1,2,1][0,0,1,2]]");
+    CHECK(StructuredSquareMatrix::identity(2).toString() == "[[1,0][0,1]]");
+    CHECK(StructuredSquareMatrix::diagonal({ 3, 4 }).toString() == "[[3,0][0,4]]");
+    CHECK(StructuredSquareMatrix{ "[]" }.toString() == "[[]]");
+    CHECK_THROWS_WITH(StructuredSquareMatrix{ "[[1,2][3]]" }, "Not a square matrix");
+}
+
+TEST_CASE("StructuredSquareMatrix arithmetic operator test", "[StructuredSquareMatrix]")
+{
+    ConcreteSquareMatrix u{ "[[2,1,3][0,-1,4][0,0,5]]" };
+    ConcreteSquareMatrix l{ "[[2,0,0][1,-1,0][3,4,5]]" };
+    ConcreteSquareMatrix d{ "[[2,0,0][0,-1,0][0,0,5]]" };
+    ConcreteSquareMatrix g{ "[[3,-1,4][-7,-2,-1][6,0,1]]" };
+    StructuredSquareMatrix su{ u };
+    StructuredSquareMatrix sl{ l };
+    StructuredSquareMatrix sd{ d };
+    StructuredSquareMatrix sg{ g };
+
+    CHECK((su + sl).toConcrete() == u + l);
+    CHECK((su - sd).toConcrete() == u - d);
+    CHECK((su * sl).toConcrete() == u * l);
+    CHECK((sl * su).toConcrete() == l * u);
+    CHECK((su * su).structure() == MatrixStructure::UpperTriangular);
+    CHECK((su * su).toConcrete() == u * u);
+    CHECK((sd * sd).structure() == MatrixStructure::Diagonal);
+    CHECK((sd * sg).toConcrete() == d * g);
+    CHECK(sd * g == d * g);
+    CHECK(g * sd == g * d);
+    CHECK(StructuredSquareMatrix::identity(3) * sg == sg);
+    CHECK(sg * StructuredSquareMatrix::identity(3) == sg);
+    CHECK((sd + StructuredSquareMatrix::identity(3)).toString() == "[[3,0,0][0,0,0][0,0,6]]");
+    CHECK(su.transpose().structure() == MatrixStructure::LowerTriangular);
+    CHECK(su.transpose().toConcrete() == u.transpose());
+    CHECK(sd == StructuredSquareMatrix{ d.toString() });
+    CHECK_FALSE(su == sl);
+
+    CHECK_THROWS_WITH(su * StructuredSquareMatrix{ "[[1]]" }, "Incompatible matrices");
+    CHECK_THROWS_WITH(su + StructuredSquareMatrix{ "[[1]]" }, "Incompatible matrices");
+    StructuredSquareMatrix big = StructuredSquareMatrix::diagonal({ 2147483647 });
+    CHECK_THROWS_AS(big + big, std::overflow_error);
+    CHECK_THROWS_AS(big * big, std::overflow_error);
+
+    // 4 * 2^62 overflows the 64-bit accumulator itself
+    ConcreteSquareMatrix min4 = ConcreteSquareMatrix::fromValues(4, std::vector<long long>(16, INT_MIN));
+    CHECK_THROWS_WITH(StructuredSquareMatrix{ min4 } * StructuredSquareMatrix{ min4 }, "Arithmetic overflow");
+    CHECK_THROWS_WITH(StructuredSquareMatrix{ min4 } * min4, "Arithmetic overflow");
+}
+
+TEST_CASE("StructuredSquareMatrix banded product test", "[StructuredSquareMatrix]")
+{
+    // Tridiagonal squared is pentadiagonal
+    StructuredSquareMatrix b{ "[[2,-1,0,0,0][-1,2,-1,0,0][0,-1,2,-1,0][0,0,-1,2,-1][0,0,0,-1,2]]" };
+    StructuredSquareMatrix b2 = b * b;
+    CHECK(b2.lowerBandwidth() == 2);
+    CHECK(b2.upperBandwidth() == 2);
+    CHECK(b2.toConcrete() == b.toConcrete() * b.toConcrete());
+    CHECK((b * b.transpose()).toConcrete() == b.toConcrete() * b.toConcrete().transpose());
+}
@@ -0,0 +1,8 @@
+/**
+	\file test_main.cpp
+	\brief Entry point of the unit test runner, kept apart from the calculator
+*/
+
+#define CATCH_CONFIG_MAIN
+
+#include "catch.hpp"
@@ -0,0 +1,54 @@
+/**
+    \file threadpool.cpp
+    \brief Implementation of the ThreadPool class
+*/
+
+#include "threadpool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int workers)
+{
+    unsigned int count = workers ? workers : std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned int i = 0; i < count; i++)
+        this->workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard{ lock };
+        stopping = true;
+    }
+    ready.notify_all();
+
+    for (auto& t : workers)
+        t.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+unsigned int ThreadPool::size() const { return static_cast<unsigned int>(workers.size()); }
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard{ lock };
+            ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+
+            // The tasks left are run before the workers stop
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
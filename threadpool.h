@@ -0,0 +1,94 @@
+/**
+    \file threadpool.h
+    \brief Header for the ThreadPool class
+*/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+/**
+    \class ThreadPool
+    \brief Defines a fixed set of worker threads running submitted tasks in submission order
+
+    The tasks must not wait for other tasks of the same pool, a pool whose
+    workers all wait would never finish.
+*/
+class ThreadPool
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param workers number of worker threads, 0 for one per hardware thread
+    */
+    explicit ThreadPool(unsigned int workers = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator =(const ThreadPool&) = delete;
+
+    /**
+        \brief Destructor, runs the tasks already submitted and joins the workers
+    */
+    ~ThreadPool();
+
+    /**
+        \brief Getter for the pool of the library, created on first use
+        \return Reference to the shared ThreadPool object
+    */
+    static ThreadPool& shared();
+
+    /**
+        \brief Getter for the number of worker threads
+        \return unsigned int value of the worker count
+    */
+    unsigned int size() const;
+
+    /**
+        \brief Method for running a task on a worker thread
+        \param f callable taking no arguments
+        \tparam F type of the callable
+        \return future holding the result of the task, or the exception it threw
+    */
+    template<typename F>
+    std::future<std::invoke_result_t<F>> submit(F f);
+
+private:
+    std::vector<std::thread> workers;
+
+    std::deque<std::function<void()>> tasks;
+
+    bool stopping = false;
+
+    std::mutex lock;
+
+    std::condition_variable ready;
+
+    // Runs tasks until the pool is destroyed
+    void work();
+};
+
+template<typename F>
+std::future<std::invoke_result_t<F>> ThreadPool::submit(F f)
+{
+    // std::function needs a copyable callable, so the task is held by a shared pointer
+    using Result = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(f));
+    std::future<Result> res = task->get_future();
+
+    {
+        std::lock_guard<std::mutex> guard{ lock };
+        tasks.emplace_back([task]() { (*task)(); });
+    }
+    ready.notify_one();
+
+    return res;
+}
@@ -0,0 +1,215 @@
+/**
+    \file workload.cpp
+    \brief Implementation of the WorkloadGenerator class and the binary matrix format
+*/
+
+#include "workload.h"
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
+#include <climits>
+
+namespace
+{
+    void check(const MatrixSpec& spec)
+    {
+        // Only letters parse as variables, and command streams assign every letter of the alphabet
+        const bool letters = std::all_of(spec.alphabet.begin(), spec.alphabet.end(), [](char c) { return c >= 'a' && c <= 'z'; });
+        if (spec.sparsity < 0 || spec.sparsity > 1 || spec.variables < 0 || spec.variables > 1
+            || spec.minValue > spec.maxValue || (spec.variables > 0 && spec.alphabet.empty()) || !letters)
+            throw std::invalid_argument("Invalid specification");
+    }
+
+    void putInt(std::string& out, std::uint32_t v)
+    {
+        for (int i = 0; i < 4; i++)
+            out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+
+    std::uint32_t getInt(const std::string& in, std::size_t& pos)
+    {
+        if (pos + 4 > in.size())
+            throw std::invalid_argument("Not a square matrix");
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; i++)
+            v |= static_cast<std::uint32_t>(static_cast<unsigned char>(in[pos + i])) << (8 * i);
+        pos += 4;
+        return v;
+    }
+}
+
+WorkloadGenerator::WorkloadGenerator(unsigned int seed) : rng(seed) {}
+
+bool WorkloadGenerator::element(const MatrixSpec& spec, int& value, char& variable)
+{
+    value = 0;
+    if (std::bernoulli_distribution(spec.sparsity)(rng))
+        return false;
+
+    if (spec.variables > 0 && std::bernoulli_distribution(spec.variables)(rng))
+    {
+        variable = spec.alphabet[std::uniform_int_distribution<std::size_t>(0, spec.alphabet.size() - 1)(rng)];
+        return true;
+    }
+
+    // Zeros come from the sparsity only, unless the range holds nothing else
+    if (spec.minValue == 0 && spec.maxValue == 0)
+        return false;
+    do
+        value = std::uniform_int_distribution<int>(spec.minValue, spec.maxValue)(rng);
+    while (value == 0);
+    return false;
+}
+
+std::string WorkloadGenerator::matrix(const MatrixSpec& spec)
+{
+    check(spec);
+    if (spec.n == 0)
+        return "[[]]";
+
+    std::string str = "[";
+    int value;
+    char variable;
+    for (unsigned int i = 0; i < spec.n; i++)
+    {
+        str.push_back('[');
+        for (unsigned int j = 0; j < spec.n; j++)
+        {
+            if (j > 0)
+                str.push_back(',');
+            if (element(spec, value, variable))
+                str.push_back(variable);
+            else
+                str.append(std::to_string(value));
+        }
+        str.push_back(']');
+    }
+    str.push_back(']');
+
+    return str;
+}
+
+std::string WorkloadGenerator::binaryMatrix(const MatrixSpec& spec)
+{
+    check(spec);
+    const bool symbolic = spec.variables > 0;
+
+    std::string out = "SQM";
+    out.push_back(symbolic ? 1 : 0);
+    putInt(out, spec.n);
+    out.reserve(out.size() + static_cast<std::size_t>(spec.n) * spec.n * (symbolic ? 5 : 4));
+
+    int value;
+    char variable;
+    for (std::size_t k = 0; k < static_cast<std::size_t>(spec.n) * spec.n; k++)
+    {
+        const bool isVariable = element(spec, value, variable);
+        if (symbolic)
+            out.push_back(isVariable ? 1 : 0);
+        if (isVariable)
+            out.push_back(variable);
+        else
+            putInt(out, static_cast<std::uint32_t>(value));
+    }
+
+    return out;
+}
+
+std::string WorkloadGenerator::commands(const CommandSpec& spec)
+{
+    check(spec.matrix);
+    std::string out;
+
+    // Every variable gets a value, so evaluating never fails
+    for (char c : spec.matrix.alphabet)
+        out.append(std::string(1, c) + "=" + std::to_string(std::uniform_int_distribution<int>(spec.matrix.minValue, spec.matrix.maxValue)(rng)) + "\n");
+
+    static const char* const operations[] = { "+", "-", "*" };
+
+    // Pushed elements each entry of the stack and each register is built from, 0 for an empty register
+    const unsigned long long n = spec.matrix.n;
+    const unsigned long long leaf = std::max(n * n, 1ULL);
+
+    // Products and loads multiply the terms on the stack instead of adding to
+    // them, so they only make small entries and the stack fills up slowly
+    const unsigned long long small = spec.maxTerms / (std::max(spec.maxDepth, 1u) * std::max(n, 1ULL));
+    std::vector<unsigned long long> stack;
+    std::vector<unsigned long long> stored(spec.registers, 0);
+    for (unsigned int i = 0; i < spec.commands; i++)
+    {
+        // Push while there are too few operands, pop while there are too many
+        const std::size_t depth = stack.size();
+        const unsigned int roll = std::uniform_int_distribution<unsigned int>(0, 9)(rng);
+        const unsigned int r = spec.registers ? std::uniform_int_distribution<unsigned int>(0, spec.registers - 1)(rng) : 0;
+        // The sum saturates, so a huge budget cannot make it wrap
+        const unsigned long long sum = depth < 2 ? 0
+            : std::min(stack[depth - 1], ULLONG_MAX - stack[depth - 2]) + stack[depth - 2];
+        if (depth >= 2 && (roll < 5 || depth >= spec.maxDepth) && sum <= spec.maxTerms)
+        {
+            // A product too large becomes a sum or a difference
+            int op = std::uniform_int_distribution<int>(0, 2)(rng);
+            if (op == 2 && sum > small / std::max(n, 1ULL))
+                op = std::uniform_int_distribution<int>(0, 1)(rng);
+            out.append(operations[op]);
+            stack.pop_back();
+            stack.back() = op == 2 ? sum * n : sum;
+        }
+        else if (depth >= 1 && (roll == 5 || depth >= std::max(spec.maxDepth, 2u)))
+            out.append("=");
+        else if (depth >= 1 && roll == 6 && spec.registers)
+        {
+            out.append("store R" + std::to_string(r));
+            stored[r] = stack.back();
+        }
+        else if (roll == 7 && spec.registers && stored[r] && stored[r] <= small && depth < spec.maxDepth)
+        {
+            out.append("load R" + std::to_string(r));
+            stack.push_back(stored[r]);
+        }
+        else
+        {
+            out.append(matrix(spec.matrix));
+            stack.push_back(leaf);
+        }
+        out.push_back('\n');
+    }
+
+    return out;
+}
+
+std::string binaryToText(const std::string& binary)
+{
+    if (binary.size() < 8 || binary.compare(0, 3, "SQM") != 0 || (binary[3] != 0 && binary[3] != 1))
+        throw std::invalid_argument("Not a square matrix");
+
+    const bool symbolic = binary[3] == 1;
+    std::size_t pos = 4;
+    const std::uint32_t n = getInt(binary, pos);
+    std::string str = n ? "[" : "[[]]";
+    for (std::uint32_t i = 0; i < n; i++)
+    {
+        str.push_back('[');
+        for (std::uint32_t j = 0; j < n; j++)
+        {
+            if (j > 0)
+                str.push_back(',');
+            // Symbolic elements start with a tag telling a value from a variable
+            const char tag = symbolic && pos < binary.size() ? binary[pos++] : 0;
+            if (tag == 1 && pos < binary.size() && isalpha(static_cast<unsigned char>(binary[pos])))
+                str.push_back(binary[pos++]);
+            else if (tag == 0)
+                str.append(std::to_string(static_cast<std::int32_t>(getInt(binary, pos))));
+            else
+                throw std::invalid_argument("Not a square matrix");
+        }
+        str.push_back(']');
+    }
+    if (n)
+        str.push_back(']');
+
+    if (pos != binary.size())
+        throw std::invalid_argument("Not a square matrix");
+    return str;
+}
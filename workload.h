@@ -0,0 +1,130 @@
+/**
+    \file workload.h
+    \brief Header for the WorkloadGenerator class and the binary matrix format
+*/
+
+#pragma once
+
+#include <string>
+#include <random>
+
+/**
+    \struct MatrixSpec
+    \brief Defines the shape and the contents of generated matrices
+*/
+struct MatrixSpec
+{
+    unsigned int n = 3;
+
+    /// Fraction of the elements that are zero
+    double sparsity = 0.0;
+
+    /// Fraction of the nonzero elements that are variables, 0 gives concrete matrices
+    double variables = 0.0;
+
+    /// Lowercase letters the variables are drawn from
+    std::string alphabet = "xyz";
+
+    /// Smallest nonzero value
+    int minValue = -9;
+
+    /// Largest nonzero value
+    int maxValue = 9;
+};
+
+/**
+    \struct CommandSpec
+    \brief Defines a generated command stream of the calculator
+*/
+struct CommandSpec
+{
+    /// Number of matrices and operations in the stream
+    unsigned int commands = 100;
+
+    /// Matrices pushed by the stream
+    MatrixSpec matrix;
+
+    /// Number of registers used by "store" and "load", 0 for none
+    unsigned int registers = 4;
+
+    /// Most matrices kept on the stack at the same time
+    unsigned int maxDepth = 8;
+
+    /// Most pushed elements a stack entry may be built from, which bounds the size of its expression
+    unsigned long long maxTerms = 1ULL << 16;
+};
+
+/**
+    \class WorkloadGenerator
+    \brief Defines a reproducible source of random matrices and calculator command streams
+
+    Generators constructed with the same seed produce the same output for the
+    same calls.
+
+    The binary form of a matrix starts with the bytes "SQM", a format byte 0
+    for concrete and 1 for symbolic matrices and n as a 32-bit little-endian
+    integer. The n * n elements follow in row-major order. A concrete element
+    is a 32-bit little-endian integer. A symbolic element is a byte 0 followed
+    by such an integer, or a byte 1 followed by the letter of a variable.
+*/
+class WorkloadGenerator
+{
+public:
+    /**
+        \brief Parametric constructor
+        \param seed seed of the random numbers
+    */
+    explicit WorkloadGenerator(unsigned int seed = 1);
+
+    /**
+        \brief Method for a random matrix in the text format
+        \param spec shape and contents of the matrix
+        \return string such as "[[1,x][0,-3]]"
+        \exception std::invalid_argument Invalid specification
+    */
+    std::string matrix(const MatrixSpec& spec);
+
+    /**
+        \brief Method for a random matrix in the binary form
+        \param spec shape and contents of the matrix
+        \return string holding the bytes of the matrix
+        \exception std::invalid_argument Invalid specification
+    */
+    std::string binaryMatrix(const MatrixSpec& spec);
+
+    /**
+        \brief Method for a random command stream of the calculator, one command per line
+        \param spec length and contents of the stream
+        \return string of the commands
+        \exception std::invalid_argument Invalid specification
+
+        The stream first assigns a value to every variable of the alphabet, so
+        every matrix can be evaluated. Every operation finds enough operands
+        of the same size on the stack and every "load" a stored register.
+
+        A symbolic product keeps copies of both operands, so repeated products
+        grow exponentially. The stream counts the pushed elements each entry is
+        built from, n * n for a new matrix, the sum of both operands for "+"
+        and "-" and n times that for "*". No entry gets more than maxTerms of
+        them, and products and loads only make entries of at most
+        maxTerms / (maxDepth * n). When no operation fits, a new matrix is
+        pushed instead, or the top is evaluated with "=" when the stack is
+        full. The calculator cannot drop an entry, so a stream with more than
+        about maxDepth * maxTerms / (n * n) matrices ends up evaluating.
+    */
+    std::string commands(const CommandSpec& spec);
+
+private:
+    std::mt19937 rng;
+
+    // Draws one element, a value or the letter of a variable
+    bool element(const MatrixSpec& spec, int& value, char& variable);
+};
+
+/**
+    \brief Function for converting a matrix from the binary form into the text format
+    \param binary string holding the bytes of the matrix
+    \return string of the matrix in the text format
+    \exception std::invalid_argument Not a square matrix
+*/
+std::string binaryToText(const std::string& binary);
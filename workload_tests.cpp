@@ -0,0 +1,148 @@
+/**
+    \file workload_tests.cpp
+    \brief Unit tests for the WorkloadGenerator class and the binary matrix format
+*/
+
+#include "catch.hpp"
+#include "workload.h"
+#include "calculator.h"
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <climits>
+
+TEST_CASE("WorkloadGenerator matrix test", "[WorkloadGenerator]")
+{
+    MatrixSpec spec;
+    spec.n = 6;
+    spec.minValue = 3;
+    spec.maxValue = 5;
+
+    // The same seed gives the same matrices
+    WorkloadGenerator a{ 7 };
+    WorkloadGenerator b{ 7 };
+    const std::string m = a.matrix(spec);
+    CHECK(m == b.matrix(spec));
+    CHECK(a.matrix(spec) != m);
+
+    ConcreteSquareMatrix c{ m };
+    CHECK(c.getN() == 6);
+    for (long long v : c.values())
+        CHECK((v >= 3 && v <= 5));
+
+    spec.sparsity = 1.0;
+    CHECK(ConcreteSquareMatrix{ a.matrix(spec) } == ConcreteSquareMatrix::fromValues(6, std::vector<long long>(36, 0)));
+
+    spec.sparsity = 0.0;
+    spec.variables = 1.0;
+    spec.alphabet = "q";
+    const std::string s = a.matrix(spec);
+    CHECK(isSymbolicSquareMatrix(s));
+    CHECK(std::count(s.begin(), s.end(), 'q') == 36);
+    CHECK(SymbolicSquareMatrix{ s }.evaluate(Valuation{ { 'q', 2 } }) == ConcreteSquareMatrix::fromValues(6, std::vector<long long>(36, 2)));
+
+    spec.n = 0;
+    CHECK(a.matrix(spec) == "[[]]");
+
+    spec.minValue = 6;
+    CHECK_THROWS_WITH(a.matrix(spec), "Invalid specification");
+
+    // Only lowercase letters parse as variables
+    spec.minValue = 3;
+    for (const char* alphabet : { "1;", "xY", "x " })
+    {
+        spec.alphabet = alphabet;
+        CHECK_THROWS_WITH(a.matrix(spec), "Invalid specification");
+        CHECK_THROWS_WITH(a.binaryMatrix(spec), "Invalid specification");
+        CHECK_THROWS_WITH(a.commands(CommandSpec{ 10, spec }), "Invalid specification");
+    }
+}
+
+TEST_CASE("WorkloadGenerator binary form test", "[WorkloadGenerator]")
+{
+    MatrixSpec spec;
+    spec.n = 5;
+    spec.sparsity = 0.3;
+    spec.minValue = -100000;
+    spec.maxValue = 100000;
+
+    // Both forms draw the same elements from the same seed
+    WorkloadGenerator text{ 3 };
+    WorkloadGenerator bin{ 3 };
+    std::string binary = bin.binaryMatrix(spec);
+    CHECK(binary.size() == 8 + 25 * 4);
+    CHECK(binaryToText(binary) == text.matrix(spec));
+
+    spec.variables = 0.5;
+    binary = bin.binaryMatrix(spec);
+    CHECK(binaryToText(binary) == text.matrix(spec));
+
+    spec.n = 0;
+    CHECK(binaryToText(bin.binaryMatrix(spec)) == "[[]]");
+
+    CHECK_THROWS_WITH(binaryToText("SQM"), "Not a square matrix");
+    CHECK_THROWS_WITH(binaryToText(binary.substr(0, binary.size() - 1)), "Not a square matrix");
+    CHECK_THROWS_WITH(binaryToText(binary + "x"), "Not a square matrix");
+    std::string tag = bin.binaryMatrix(MatrixSpec{ 1, 0.0, 1.0, "x", 1, 1 });
+    CHECK(binaryToText(tag) == "[[x]]");
+    tag[8] = 2;
+    CHECK_THROWS_WITH(binaryToText(tag), "Not a square matrix");
+}
+
+TEST_CASE("WorkloadGenerator command stream test", "[WorkloadGenerator]")
+{
+    CommandSpec spec;
+    spec.commands = 60;
+    spec.matrix.n = 2;
+    spec.matrix.variables = 0.3;
+    spec.matrix.minValue = -2;
+    spec.matrix.maxValue = 2;
+    spec.maxDepth = 3;
+    spec.maxTerms = 128;
+
+    // The same seed gives the same stream
+    WorkloadGenerator gen{ 11 };
+    const std::string stream = gen.commands(spec);
+    CHECK(stream == WorkloadGenerator{ 11 }.commands(spec));
+    CHECK(stream.find("x=") == 0);
+    CHECK(std::count(stream.begin(), stream.end(), '\n') == 63);
+    CHECK(stream.find("store R") != std::string::npos);
+    CHECK(stream.find("load R") != std::string::npos);
+    CHECK(stream.find("\n*\n") != std::string::npos);
+
+    // Every command of the stream is valid, so only the top of the stack is printed
+    std::istringstream in{ stream };
+    std::ostringstream out;
+    Calculator calc{ out, false, true };
+    calc.run(in);
+    const std::string top = out.str();
+    CHECK(std::count(top.begin(), top.end(), '\n') == 1);
+    CHECK(calc.depth() <= spec.maxDepth);
+
+    // The budget bounds the pushed elements the top is built from, a variable or a run of digits each
+    std::size_t terms = 0;
+    bool digits = false;
+    for (char c : top)
+    {
+        const bool digit = isdigit(static_cast<unsigned char>(c)) != 0;
+        if (isalpha(static_cast<unsigned char>(c)) || (digit && !digits))
+            terms++;
+        digits = digit;
+    }
+    CHECK(terms > 0);
+    CHECK(terms <= spec.maxTerms);
+
+    // A full stack of entries that cannot be combined is only evaluated
+    spec.maxTerms = 4;
+    const std::string full = gen.commands(spec);
+    CHECK(full.substr(full.size() - 4) == "=\n=\n");
+
+    // A budget too large to reach never makes the counts wrap
+    spec.maxTerms = ULLONG_MAX;
+    std::istringstream huge{ gen.commands(spec) };
+    std::ostringstream hugeOut;
+    Calculator hugeCalc{ hugeOut, false, true };
+    hugeCalc.run(huge);
+    const std::string hugeTop = hugeOut.str();
+    CHECK(std::count(hugeTop.begin(), hugeTop.end(), '\n') == 1);
+}